@@ -0,0 +1,222 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "platform.hpp"
+#include "settings.hpp"
+#include "spike/io/bincore_fwd.hpp"
+#include "spike/util/supercore.hpp"
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace revil {
+class ARCCodecImpl;
+class ARCArchiveImpl;
+
+/*
+Compression context for ARC entries.
+zlib streams are created once and reused by inflateReset/deflateReset.
+Context is not thread safe, use one context per thread or ThreadContext().
+*/
+class RE_EXTERN ARCCodec {
+public:
+  // zlib compression levels
+  static constexpr int LEVEL_STORE = 0;
+  static constexpr int LEVEL_FASTEST = 1;
+  static constexpr int LEVEL_DEFAULT = 6;
+  static constexpr int LEVEL_BEST = 9;
+
+  ARCCodec();
+  ARCCodec(ARCCodec &&);
+  ~ARCCodec();
+
+  // Returns number of decompressed bytes
+  size_t Inflate(std::string_view in, std::span<char> out);
+  // XMemCompress streams, out size must be exact uncompressed size
+  size_t InflateLZX(std::string_view in, std::span<char> out,
+                    uint32 windowBits);
+  // Returns number of compressed bytes, out should be at least DeflateBound
+  size_t Deflate(std::string_view in, std::span<char> out, int level,
+                 uint32 windowBits);
+  static size_t DeflateBound(size_t inSize);
+
+  // Context owned by calling thread
+  static ARCCodec &ThreadContext();
+
+private:
+  std::unique_ptr<ARCCodecImpl> pi;
+};
+
+struct ARCEntry {
+  std::string_view fileName; // without extension
+  uint32 typeHash;
+  uint32 compressedSize;
+  uint32 uncompressedSize;
+  uint32 offset;
+};
+
+/*
+Table of contents view over raw ARC records.
+Records are decoded on access, big endian records are swapped per access.
+*/
+class ARCEntries {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = ARCEntry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = ARCEntry;
+
+    iterator() = default;
+    iterator(const ARCEntries *owner_, size_t index_)
+        : owner(owner_), index(index_) {}
+
+    ARCEntry operator*() const { return (*owner)[index]; }
+    ARCEntry operator[](difference_type n) const { return (*owner)[index + n]; }
+    iterator &operator++() { return index++, *this; }
+    iterator operator++(int) { return {owner, index++}; }
+    iterator &operator--() { return index--, *this; }
+    iterator operator--(int) { return {owner, index--}; }
+    iterator &operator+=(difference_type n) { return index += n, *this; }
+    iterator &operator-=(difference_type n) { return index -= n, *this; }
+    iterator operator+(difference_type n) const { return {owner, index + n}; }
+    iterator operator-(difference_type n) const { return {owner, index - n}; }
+    friend iterator operator+(difference_type n, iterator it) { return it + n; }
+    difference_type operator-(iterator other) const {
+      return difference_type(index) - difference_type(other.index);
+    }
+    auto operator<=>(const iterator &other) const {
+      return index <=> other.index;
+    }
+    bool operator==(const iterator &other) const {
+      return index == other.index;
+    }
+
+  private:
+    const ARCEntries *owner = nullptr;
+    size_t index = 0;
+  };
+
+  ARCEntries() = default;
+  ARCEntries(const char *data_, size_t numItems_, size_t nameSize_,
+             bool swapEndian_)
+      : data(data_), numItems(numItems_), nameSize(nameSize_),
+        swapEndian(swapEndian_) {}
+
+  size_t size() const { return numItems; }
+  bool empty() const { return !numItems; }
+  iterator begin() const { return {this, 0}; }
+  iterator end() const { return {this, numItems}; }
+
+  ARCEntry operator[](size_t index) const {
+    const char *record = data + index * Stride();
+    uint32 values[4];
+    memcpy(values, record + nameSize, sizeof(values));
+
+    if (swapEndian) {
+      for (uint32 &v : values) {
+        v = std::byteswap(v);
+      }
+    }
+
+    ARCEntry retVal;
+    retVal.fileName = {record, strnlen(record, nameSize)};
+    retVal.typeHash = values[0];
+    retVal.compressedSize = values[1];
+    retVal.uncompressedSize = values[2] & 0x1FFFFFFF; // upper bits are flags
+    retVal.offset = values[3];
+
+    return retVal;
+  }
+
+private:
+  const char *data = nullptr;
+  size_t numItems = 0;
+  size_t nameSize = 0;
+  bool swapEndian = false;
+
+  size_t Stride() const { return nameSize + sizeof(uint32) * 4; }
+};
+
+struct ARCWriteEntry {
+  std::string_view fileName; // without extension
+  uint32 typeHash;
+  uint32 compressedSize;
+  uint32 uncompressedSize;
+};
+
+// Writes ARC header and table of contents, big endian platforms produce CRA
+// Entry data must follow in the same order, returns offset of the first entry
+size_t RE_EXTERN WriteARCHeader(BinWritterRef_e wr,
+                                std::span<const ARCWriteEntry> entries,
+                                const ArcSupport &support, Platform platform);
+
+/*
+Random access MTF archive (ARC, CRA, ARCC and extended path ARC).
+Archive is memory mapped, only requested entries are decompressed.
+HFS wrapped archives are unwrapped into memory.
+*/
+class RE_EXTERN ARCArchive {
+public:
+  // Title selects extended file paths and encryption key
+  // Auto platform is detected from archive endianness
+  ARCArchive(const std::string &path, std::string_view title = {},
+             Platform platform = Platform::Auto);
+  ARCArchive(ARCArchive &&);
+  ~ARCArchive();
+
+  const ARCEntries &Entries() const;
+  uint16 Version() const;
+  Platform GetPlatform() const;
+
+  // Returns Entries().size() when not found
+  // Names are case insensitive and '/' matches '\\'
+  // Name index is built on first lookup unless loaded by LoadIndex
+  size_t Find(std::string_view fileName) const;
+  size_t Find(std::string_view fileName, uint32 typeHash) const;
+  // Path with extension as written by extract_arc: "folder\\name.ext"
+  // Unregistered classes use hexadecimal type hash as extension
+  size_t FindPath(std::string_view path) const;
+
+  // Optional persisted name index for archives that are opened repeatedly
+  // Returns false when sidecar is missing, corrupt or does not match the
+  // archive, or when a lookup already built the index
+  // Must be called before any lookup, it does not wait for concurrent ones
+  bool LoadIndex(const std::string &indexPath);
+  void SaveIndex(const std::string &indexPath) const;
+
+  // Stored entry data, might be compressed or encrypted
+  std::string_view RawData(size_t index) const;
+
+  // Decompresses single entry into out, out must be at least uncompressedSize
+  // Returns number of written bytes
+  size_t Read(size_t index, std::span<char> out,
+              ARCCodec &codec = ARCCodec::ThreadContext()) const;
+  size_t Read(std::string_view fileName, std::span<char> out,
+              ARCCodec &codec = ARCCodec::ThreadContext()) const;
+
+private:
+  std::unique_ptr<ARCArchiveImpl> pi;
+};
+} // namespace revil
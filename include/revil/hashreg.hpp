@@ -21,6 +21,7 @@
 #include "settings.hpp"
 #include <functional>
 #include <string_view>
+#include <vector>
 
 namespace revil {
 using Platforms = std::vector<Platform>;
@@ -33,6 +34,43 @@ std::string_view RE_EXTERN GetClassName(uint32 hash,
                                        Platform platform = Platform::Win32);
 uint32 RE_EXTERN GetHash(std::string_view extension, std::string_view title,
                          Platform platform = Platform::Win32);
+
+// Resolved hash -> extension lookup for a single title and platform
+// Lookup order is the same as GetExtension, but costs a single table probe
+class RE_EXTERN ExtensionResolver {
+public:
+  ExtensionResolver(std::string_view title = {},
+                    Platform platform = Platform::Win32);
+
+  std::string_view operator()(uint32 hash) const {
+    for (size_t i = Index(hash);; i = (i + 1) & mask) {
+      const Slot &slot = slots[i];
+
+      if (!slot.extension) {
+        return {};
+      }
+
+      if (slot.hash == hash) {
+        return {slot.extension, slot.extensionSize};
+      }
+    }
+  }
+
+private:
+  struct Slot {
+    uint32 hash = 0;
+    uint32 extensionSize = 0;
+    const char *extension = nullptr;
+  };
+
+  std::vector<Slot> slots;
+  size_t mask = 0;
+  uint32 shift = 0;
+
+  size_t Index(uint32 hash) const { return (hash * 0x9E3779B1) >> shift; }
+  void Insert(uint32 hash, std::string_view extension);
+};
+
 using TitleCallback = std::function<void(std::string_view)>;
 void RE_EXTERN GetTitles(TitleCallback cb);
 
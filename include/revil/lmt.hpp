@@ -35,6 +35,14 @@ struct LMTExportSettings {
   bool swapEndian = false;
 };
 
+// Animation header read without constructing animation
+struct LMTBlockInfo {
+  uint32 offset = 0; // 0 for empty slot
+  uint32 numTracks = 0;
+  uint32 numFrames = 0;
+  int32 loopFrame = 0;
+};
+
 class LMTImpl;
 
 class RE_EXTERN LMT {
@@ -47,11 +55,21 @@ public:
   LMTArchType Architecture() const;
   auto CreateAnimation() const;
 
+  // Number of animation slots, empty slots included
+  size_t NumBlocks() const;
+  LMTBlockInfo BlockInfo(size_t index) const;
+  // Loaded animations are constructed on first access, thread safe
+  // Returns nullptr for empty slot
+  const LMTAnimation *Animation(size_t index) const;
+
   LMTAnimation *AppendAnimation();
   void AppendAnimation(LMTAnimation *ani);
   void InsertAnimation(LMTAnimation *ani, size_t at, bool replace = false);
 
   void Load(BinReaderRef_e rd);
+  // Memory maps file instead of reading it
+  // Key data is not read (or byteswapped) until track is sampled
+  void LoadMapped(const std::string &fileName);
   void Load(const std::string &fileName, LMTImportOverrides overrides = {});
   void Load(pugi::xml_node node, std::string_view outPath,
             LMTImportOverrides overrides = {});
@@ -23,6 +23,7 @@
 #include <variant>
 #include <vector>
 #include <map>
+#include <span>
 
 namespace revil {
 
@@ -101,8 +102,15 @@ public:
   Create(const LMTConstructorProperties &props);
 };
 
+// Keyframe position kept between sequential GetValue calls
+struct LMTTrackCursor {
+  size_t frame = 0;
+};
+
 class LMTTrack : public uni::MotionTrack {
 public:
+  using uni::MotionTrack::GetValue;
+
   enum TrackType_e {
     TrackType_LocalRotation,
     TrackType_LocalPosition,
@@ -121,6 +129,13 @@ public:
   virtual size_t Stride() const = 0;
   virtual uint32 BoneType() const = 0;
   virtual std::string_view CompressionType() const = 0;
+  // Keyframe lookup starts at cursor, fastest for ascending times
+  virtual void GetValue(Vector4A16 &out, float time,
+                        LMTTrackCursor &cursor) const = 0;
+  // Samples whole channel, out[i] is value at times[i]
+  // out must be at least times.size()
+  virtual void GetValues(std::span<Vector4A16> out,
+                         std::span<const float> times) const = 0;
 
   static RE_EXTERN std::unique_ptr<LMTTrack>
   Create(const LMTConstructorProperties &props);
@@ -155,4 +170,46 @@ public:
     return !operator==(input);
   }
 };
+
+// Local transforms of animated bones at single time
+// Arrays are indexed same as LMTPoseEvaluator::Bones()
+struct LMTPose {
+  std::vector<Vector4A16> rotations;
+  std::vector<Vector4A16> translations;
+  std::vector<Vector4A16> scales;
+};
+
+struct LMTPoseBone {
+  uint32 index; // LMTTrack::BoneIndex
+  uint32 boneType;
+  uint8 trackTypes; // 1 << LMTTrack::TrackType_e for every animated channel
+};
+
+class LMTPoseEvaluatorImpl;
+
+/*
+Animation compiled for whole pose sampling.
+Keys of all tracks are decoded once into structure of arrays pools and
+tracks are grouped by bone, evaluation does not touch source animation.
+Results are identical to LMTTrack::GetValue.
+Evaluation is thread safe.
+*/
+class RE_EXTERN LMTPoseEvaluator {
+public:
+  explicit LMTPoseEvaluator(const LMTAnimation &animation,
+                            float frameRate = 60.f);
+  LMTPoseEvaluator(LMTPoseEvaluator &&);
+  ~LMTPoseEvaluator();
+
+  std::span<const LMTPoseBone> Bones() const;
+  float Duration() const;
+
+  // Channels that are not animated are set to identity
+  void Evaluate(LMTPose &pose, float time) const;
+  // poses[i] is evaluated at times[i], ascending times are fastest
+  void Evaluate(std::span<LMTPose> poses, std::span<const float> times) const;
+
+private:
+  std::unique_ptr<LMTPoseEvaluatorImpl> pi;
+};
 } // namespace revil
@@ -21,6 +21,7 @@
 #include "spike/format/DDS.hpp"
 #include "platform.hpp"
 #include "settings.hpp"
+#include <memory>
 #include <string>
 
 namespace revil {
@@ -32,6 +33,9 @@ struct Tex2DdsSettings {
   Platform platformOverride = Platform::Auto;
 };
 
+struct TEXDeferred;
+struct TEXInternal;
+
 struct RE_EXTERN TEX {
   DDS asDDS{};
   Vector4A16 color;
@@ -39,6 +43,36 @@ struct RE_EXTERN TEX {
   DDS::Mips mips;
 
   void Load(BinReaderRef_e rd, Platform platform = Platform::Auto);
+  /*
+  Reads header and surface offsets only, buffer stays empty.
+  asDDS, mips and color are filled as Load would fill them.
+  Returns platform texture is stored for, detected when Auto.
+  */
+  Platform Probe(BinReaderRef_e rd, Platform platform = Platform::Auto);
+  /*
+  Reads texture without converting pixels.
+  asDDS, mips and buffer size are final once this returns.
+  Conversion is split into NumTasks() tasks, one per mip level of every
+  array slice. Tasks write distinct parts of buffer, so they can run in any
+  order and on any thread. Every task must run exactly once.
+  Load is LoadDeferred followed by all tasks.
+  */
+  void LoadDeferred(BinReaderRef_e rd, Platform platform = Platform::Auto);
+  size_t NumTasks() const;
+  // Pending data is released by the last finished task, NumTasks() is 0 then
+  void RunTask(size_t index);
   void SaveAsDDS(BinWritterRef wr, Tex2DdsSettings settings);
+  /*
+  Converts texture into DDS one surface at a time, buffer is never filled.
+  Memory use is bounded by the largest mip, not by texture size.
+  Output is identical to Load followed by SaveAsDDS.
+  */
+  void StreamAsDDS(BinReaderRef_e rd, BinWritterRef wr,
+                   Tex2DdsSettings settings);
+
+private:
+  friend struct TEXInternal;
+  // Pixel conversion pending after LoadDeferred
+  std::shared_ptr<TEXDeferred> deferred;
 };
 } // namespace revil
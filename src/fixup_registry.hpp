@@ -0,0 +1,125 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "spike/type/pointer.hpp"
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace revil {
+/*
+Registry of already fixed pointers shared by MTF and RE engine loaders.
+Pointers reachable from multiple owners are fixed only once.
+Open addressing set with linear probing, membership test is O(1).
+Spike fixup helpers expect linear store, registry passes them empty scratch
+store, so they never search.
+*/
+class FixupRegistry {
+public:
+  FixupRegistry() : slots(MIN_CAPACITY) {}
+
+  // Returns false when address is already registered
+  bool Insert(const void *address) {
+    if ((numItems + 1) * 2 > slots.size()) {
+      Grow();
+    }
+
+    const uintptr_t key = reinterpret_cast<uintptr_t>(address);
+
+    for (size_t i = Slot(key);; i = (i + 1) & (slots.size() - 1)) {
+      if (slots[i] == key) {
+        return false;
+      }
+
+      if (!slots[i]) {
+        slots[i] = key;
+        numItems++;
+        return true;
+      }
+    }
+  }
+
+  bool Contains(const void *address) const {
+    const uintptr_t key = reinterpret_cast<uintptr_t>(address);
+
+    for (size_t i = Slot(key);; i = (i + 1) & (slots.size() - 1)) {
+      if (slots[i] == key) {
+        return true;
+      }
+
+      if (!slots[i]) {
+        return false;
+      }
+    }
+  }
+
+  size_t Size() const { return numItems; }
+
+  // Fixes pointer unconditionally, owner should be registered by Insert
+  template <class P> void Fixup(P &&ptr, char *base) {
+    ptr.Fixup(base, scratch);
+    scratch.clear();
+  }
+
+  // Pointer must live in fixed buffer, its address is the key
+  template <class P> bool FixupOnce(P &ptr, char *base) {
+    if (!Insert(&ptr)) {
+      return false;
+    }
+
+    Fixup(ptr, base);
+    return true;
+  }
+
+  // es::FixupPointers keyed by first pointer
+  template <class P, class... R>
+  bool FixupPointers(char *base, P &first, R &...rest) {
+    if (!Insert(&first)) {
+      return false;
+    }
+
+    es::FixupPointers(base, scratch, first, rest...);
+    scratch.clear();
+    return true;
+  }
+
+private:
+  static constexpr size_t MIN_CAPACITY = 256;
+  std::vector<uintptr_t> slots;
+  size_t numItems = 0;
+  std::vector<void *> scratch;
+
+  size_t Slot(uintptr_t key) const {
+    // Fibonacci hashing, low bits of aligned pointers are zero
+    const uint64 hash = uint64(key >> 2) * 0x9E3779B97F4A7C15ULL;
+    return hash >> (64 - std::countr_zero(slots.size()));
+  }
+
+  void Grow() {
+    std::vector<uintptr_t> oldSlots(slots.size() * 2);
+    std::swap(oldSlots, slots);
+    numItems = 0;
+
+    for (uintptr_t key : oldSlots) {
+      if (key) {
+        Insert(reinterpret_cast<const void *>(key));
+      }
+    }
+  }
+};
+} // namespace revil
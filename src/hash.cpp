@@ -1,42 +1,9 @@
+#include "hash.hpp"
 #include "revil/hashreg.hpp"
 #include <cstring>
 
 // Basically butchered Mersenne Twister
-uint32 revil::MTHashV1(std::string_view text) {
-  uint32 retVal = 0;
-  uint32 mtData[624];
-
-  auto makeSeed = [&](uint32 seed) {
-    mtData[0] = seed & 0xFFFF0000;
-    seed = 0x10DCD * seed + 1;
-    mtData[0] |= seed >> 16;
-
-    for (size_t i = 1; i < 624; i++) {
-      seed = 0x10DCD * seed + 1;
-      mtData[i] = seed & 0xFFFF0000;
-      seed = 0x10DCD * seed + 1;
-      mtData[i] |= seed >> 16;
-    }
-  };
-
-  makeSeed(2004);
-
-  for (size_t i = 0; i < text.size(); i++) {
-    auto nextChar = i + 1 == text.size() ? 0 : text[i + 1];
-    makeSeed((nextChar - 32) | ((text[i] - 32) << 6));
-    uint32 tmp0 = mtData[0] ^ ((mtData[0] ^ mtData[1]) & 0x7FFFFFFF);
-    uint32 tmp1 = mtData[397] ^ (0x9908B0DF * (tmp0 & 1)) ^ (tmp0 >> 1);
-    tmp1 ^= tmp1 >> 11;
-
-    retVal ^= (((((tmp1 & 0xFF3A58AD) << 7) ^ tmp1) & 0xFFFFDF8C) << 15) ^
-              ((tmp1 & 0xFF3A58AD) << 7) ^ tmp1 ^
-              (((((((tmp1 & 0xFF3A58AD) << 7) ^ tmp1) & 0xFFFFDF8C) << 15) ^
-                ((tmp1 & 0xFF3A58AD) << 7) ^ tmp1) >>
-               18);
-  }
-
-  return retVal & 0x7FFFFFFF;
-}
+uint32 revil::MTHashV1(std::string_view text) { return MTHashV1Const(text); }
 
 static const uint32 crc32bBoxes[][0x100] = {
     {
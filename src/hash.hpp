@@ -0,0 +1,102 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "spike/util/supercore.hpp"
+#include <array>
+#include <string_view>
+
+namespace revil {
+namespace detail {
+struct LCGJump {
+  uint32 mul = 1;
+  uint32 add = 0;
+};
+
+// Seeding LCG advanced by N steps is (mul * seed + add)
+// Only mtData[0], mtData[1] and mtData[397] are ever used by MTHashV1
+constexpr std::array<LCGJump, 796> MakeLCGJumps() {
+  std::array<LCGJump, 796> retVal{};
+
+  for (size_t i = 1; i < retVal.size(); i++) {
+    retVal[i].mul = retVal[i - 1].mul * 0x10DCD;
+    retVal[i].add = retVal[i - 1].add * 0x10DCD + 1;
+  }
+
+  return retVal;
+}
+
+inline constexpr std::array<LCGJump, 796> LCG_JUMPS = MakeLCGJumps();
+
+constexpr uint32 MTSeedSlot(uint32 seed, size_t index) {
+  const LCGJump hi = LCG_JUMPS[index * 2];
+  const LCGJump lo = LCG_JUMPS[index * 2 + 1];
+  return ((hi.mul * seed + hi.add) & 0xFFFF0000) |
+         ((lo.mul * seed + lo.add) >> 16);
+}
+
+constexpr std::array<uint32, 0x100> MakeCRC32Box() {
+  std::array<uint32, 0x100> retVal{};
+
+  for (uint32 i = 0; i < 0x100; i++) {
+    uint32 value = i;
+
+    for (size_t b = 0; b < 8; b++) {
+      value = (value >> 1) ^ (0xEDB88320 & (0 - (value & 1)));
+    }
+
+    retVal[i] = value;
+  }
+
+  return retVal;
+}
+
+inline constexpr std::array<uint32, 0x100> CRC32_BOX = MakeCRC32Box();
+} // namespace detail
+
+// Compile time variants of MTHashV1 and MTHashV2
+// Results are identical to the exported functions
+constexpr uint32 MTHashV1Const(std::string_view text) {
+  uint32 retVal = 0;
+
+  for (size_t i = 0; i < text.size(); i++) {
+    const int nextChar = i + 1 == text.size() ? 0 : text[i + 1];
+    const uint32 seed = (nextChar - 32) | ((text[i] - 32) << 6);
+    const uint32 mt0 = detail::MTSeedSlot(seed, 0);
+    const uint32 mt1 = detail::MTSeedSlot(seed, 1);
+    const uint32 mt397 = detail::MTSeedSlot(seed, 397);
+    const uint32 tmp0 = mt0 ^ ((mt0 ^ mt1) & 0x7FFFFFFF);
+    uint32 tmp1 = mt397 ^ (0x9908B0DF * (tmp0 & 1)) ^ (tmp0 >> 1);
+    tmp1 ^= tmp1 >> 11;
+    tmp1 ^= (tmp1 & 0xFF3A58AD) << 7;
+    tmp1 ^= (tmp1 & 0xFFFFDF8C) << 15;
+    retVal ^= tmp1 ^ (tmp1 >> 18);
+  }
+
+  return retVal & 0x7FFFFFFF;
+}
+
+constexpr uint32 MTHashV2Const(std::string_view text) {
+  uint32 retVal = 0xFFFFFFFF;
+
+  for (char c : text) {
+    retVal = (retVal >> 8) ^ detail::CRC32_BOX[(retVal ^ uint8(c)) & 0xFF];
+  }
+
+  return retVal & 0x7FFFFFFF;
+}
+} // namespace revil
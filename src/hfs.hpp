@@ -17,7 +17,9 @@
 
 #pragma once
 #include "spike/io/binreader_stream.hpp"
-#include <sstream>
+#include <algorithm>
+#include <istream>
+#include <vector>
 
 static constexpr uint32 SFHID = CompileFourCC("\0SFH");
 
@@ -36,32 +38,139 @@ struct HFS {
   }
 };
 
-std::stringstream ProcessHFS(BinReaderRef_e rd) {
-  std::stringstream str;
-  constexpr size_t chunkSize = 0x20000;
-  char tempBuffer[chunkSize];
-  HFS hdr;
-  rd.Read(hdr);
+/*
+Unwraps HFS on the fly, logical offsets are mapped to physical chunk offsets.
+Every 0x20000 byte chunk ends with 16 byte checksum.
+Base stream must outlive this buffer and must not be used meanwhile.
+*/
+class HFSStreamBuf : public std::streambuf {
+public:
+  static constexpr size_t CHUNK_SIZE = 0x20000;
+  static constexpr size_t CHUNK_DATA_SIZE = CHUNK_SIZE - 16;
+
+  HFSStreamBuf(std::istream &base_) : base(&base_), buffer(0x8000) {
+    HFS hdr;
+    origin = base->tellg();
+    base->read(reinterpret_cast<char *>(&hdr), sizeof(hdr));
+
+    if (hdr.id == SFHID) {
+      hdr.SwapEndian();
+    }
+
+    fileSize = hdr.fileSize;
+    setg(buffer.data(), buffer.data(), buffer.data());
+  }
+
+  size_t Size() const { return fileSize; }
+
+protected:
+  int_type underflow() override {
+    if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+    }
 
-  if (hdr.id == SFHID) {
-    hdr.SwapEndian();
+    const size_t pos = Tell();
+    const size_t numRead = ReadRaw(buffer.data(), pos, buffer.size());
+    bufferBegin = pos;
+    setg(buffer.data(), buffer.data(), buffer.data() + numRead);
+
+    if (!numRead) {
+      return traits_type::eof();
+    }
+
+    return traits_type::to_int_type(*gptr());
   }
 
-  int64 fileSize = hdr.fileSize;
+  std::streamsize xsgetn(char *s, std::streamsize count) override {
+    const size_t buffered =
+        std::min<size_t>(count, size_t(egptr() - gptr()));
+    std::copy_n(gptr(), buffered, s);
+    gbump(buffered);
 
-  while (true) {
-    if (fileSize < chunkSize) {
-      rd.ReadBuffer(tempBuffer, fileSize);
-      str.write(tempBuffer, fileSize);
-      rd.ApplyPadding(16);
-      rd.Skip(16);
-      break;
+    const size_t pos = Tell();
+    const size_t numRead = ReadRaw(s + buffered, pos, count - buffered);
+    bufferBegin = pos + numRead;
+    setg(buffer.data(), buffer.data(), buffer.data());
+
+    return buffered + numRead;
+  }
+
+  pos_type seekoff(off_type offset, std::ios_base::seekdir way,
+                   std::ios_base::openmode which) override {
+    if (way == std::ios_base::cur) {
+      offset += Tell();
+    } else if (way == std::ios_base::end) {
+      offset += fileSize;
     }
 
-    rd.ReadBuffer(tempBuffer, chunkSize);
-    str.write(tempBuffer, chunkSize - 16);
-    fileSize -= chunkSize - 16;
+    return seekpos(offset, which);
   }
 
-  return str;
-}
+  pos_type seekpos(pos_type pos,
+                   std::ios_base::openmode which) override {
+    if (!(which & std::ios_base::in) || pos < 0 ||
+        size_t(pos) > fileSize) {
+      return pos_type(off_type(-1));
+    }
+
+    const size_t newPos = pos;
+
+    if (newPos >= bufferBegin &&
+        newPos <= bufferBegin + size_t(egptr() - eback())) {
+      setg(eback(), eback() + (newPos - bufferBegin), egptr());
+    } else {
+      bufferBegin = newPos;
+      setg(buffer.data(), buffer.data(), buffer.data());
+    }
+
+    return pos;
+  }
+
+private:
+  std::istream *base;
+  std::streamoff origin = 0;
+  size_t fileSize = 0;
+  size_t bufferBegin = 0;
+  std::vector<char> buffer;
+
+  size_t Tell() const { return bufferBegin + (gptr() - eback()); }
+
+  // Reads logical range, crossing chunk boundaries
+  size_t ReadRaw(char *dst, size_t pos, size_t count) {
+    count = std::min(count, fileSize - std::min(pos, fileSize));
+    size_t numRead = 0;
+
+    while (numRead < count) {
+      const size_t chunk = pos / CHUNK_DATA_SIZE;
+      const size_t inChunk = pos % CHUNK_DATA_SIZE;
+      const size_t toRead =
+          std::min(count - numRead, CHUNK_DATA_SIZE - inChunk);
+      base->clear();
+      base->seekg(origin + std::streamoff(sizeof(HFS) + chunk * CHUNK_SIZE +
+                                          inChunk));
+      base->read(dst + numRead, toRead);
+      const size_t gotBytes = base->gcount();
+      numRead += gotBytes;
+      pos += gotBytes;
+
+      if (gotBytes != toRead) {
+        break;
+      }
+    }
+
+    return numRead;
+  }
+};
+
+// Input stream over HFS payload, usable with BinReaderRef_e
+class HFSStream : public std::istream {
+public:
+  HFSStream(std::istream &base) : std::istream(nullptr), buf(base) {
+    rdbuf(&buf);
+  }
+
+  size_t Size() const { return buf.Size(); }
+
+private:
+  HFSStreamBuf buf;
+};
@@ -0,0 +1,148 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "mapped_file.hpp"
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace revil {
+#if defined(_WIN32)
+MappedFile::MappedFile(const std::string &path, bool copyOnWrite) {
+  const int wideSize =
+      MultiByteToWideChar(CP_UTF8, 0, path.data(), path.size(), nullptr, 0);
+  std::wstring widePath(wideSize, L'\0');
+  MultiByteToWideChar(CP_UTF8, 0, path.data(), path.size(), widePath.data(),
+                      wideSize);
+
+  HANDLE file =
+      CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Cannot open file: " + path);
+  }
+
+  LARGE_INTEGER fileSize{};
+  GetFileSizeEx(file, &fileSize);
+  dataSize = fileSize.QuadPart;
+
+  if (!dataSize) {
+    CloseHandle(file);
+    return;
+  }
+
+  mapping = CreateFileMappingW(file, nullptr,
+                               copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0,
+                               0, nullptr);
+  CloseHandle(file);
+
+  if (!mapping) {
+    throw std::runtime_error("Cannot map file: " + path);
+  }
+
+  data = static_cast<char *>(MapViewOfFile(
+      mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0));
+
+  if (!data) {
+    CloseHandle(mapping);
+    throw std::runtime_error("Cannot map file: " + path);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (data) {
+    UnmapViewOfFile(data);
+  }
+
+  if (mapping) {
+    CloseHandle(mapping);
+  }
+}
+
+MappedFile::MappedFile(MappedFile &&other)
+    : data(std::exchange(other.data, nullptr)),
+      dataSize(std::exchange(other.dataSize, 0)),
+      mapping(std::exchange(other.mapping, nullptr)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) {
+  std::swap(data, other.data);
+  std::swap(dataSize, other.dataSize);
+  std::swap(mapping, other.mapping);
+  return *this;
+}
+#else
+MappedFile::MappedFile(const std::string &path, bool copyOnWrite) {
+  const int file = open(path.c_str(), O_RDONLY);
+
+  if (file < 0) {
+    throw std::runtime_error("Cannot open file: " + path);
+  }
+
+  struct stat fileStat {};
+
+  if (fstat(file, &fileStat) < 0) {
+    close(file);
+    throw std::runtime_error("Cannot stat file: " + path);
+  }
+
+  dataSize = fileStat.st_size;
+
+  if (!dataSize) {
+    close(file);
+    return;
+  }
+
+  const int protection = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+  void *mapped = mmap(nullptr, dataSize, protection, MAP_PRIVATE, file, 0);
+  close(file);
+
+  if (mapped == MAP_FAILED) {
+    dataSize = 0;
+    throw std::runtime_error("Cannot map file: " + path);
+  }
+
+  data = static_cast<char *>(mapped);
+}
+
+MappedFile::~MappedFile() {
+  if (data) {
+    munmap(data, dataSize);
+  }
+}
+
+MappedFile::MappedFile(MappedFile &&other)
+    : data(std::exchange(other.data, nullptr)),
+      dataSize(std::exchange(other.dataSize, 0)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) {
+  std::swap(data, other.data);
+  std::swap(dataSize, other.dataSize);
+  return *this;
+}
+#endif
+} // namespace revil
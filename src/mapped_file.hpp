@@ -0,0 +1,47 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "spike/util/supercore.hpp"
+#include <string>
+#include <string_view>
+
+namespace revil {
+// Read only memory mapped file
+// Copy on write mapping is writable, written pages are private to process
+// and never stored back to file
+class MappedFile {
+public:
+  MappedFile() = default;
+  MappedFile(const std::string &path, bool copyOnWrite = false);
+  MappedFile(MappedFile &&other);
+  MappedFile &operator=(MappedFile &&other);
+  MappedFile(const MappedFile &) = delete;
+  ~MappedFile();
+
+  std::string_view Data() const { return {data, dataSize}; }
+  // Copy on write mappings only
+  char *MutableData() { return data; }
+
+private:
+  char *data = nullptr;
+  size_t dataSize = 0;
+#if defined(_WIN32)
+  void *mapping = nullptr;
+#endif
+};
+} // namespace revil
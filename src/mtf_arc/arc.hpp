@@ -92,7 +92,7 @@ struct ARC : ARCBase {
 using ARCFiles = std::vector<ARCFile>;
 using ARCExtendedFiles = std::vector<ARCExtendedFile>;
 
-auto ReadARC(BinReaderRef_e rd) {
+inline auto ReadARC(BinReaderRef_e rd) {
   ARC hdr;
   rd.Read(hdr);
 
@@ -113,7 +113,7 @@ auto ReadARC(BinReaderRef_e rd) {
   return std::make_tuple(hdr, files);
 }
 
-auto ReadExtendedARC(BinReaderRef_e rd) {
+inline auto ReadExtendedARC(BinReaderRef_e rd) {
   ARC hdr;
   rd.Read(hdr);
 
@@ -0,0 +1,475 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "../hash.hpp"
+#include "../mapped_file.hpp"
+#include "revil/arc.hpp"
+#include "revil/hashreg.hpp"
+#include "spike/crypto/blowfish.h"
+#include "spike/except.hpp"
+#include <algorithm>
+#include <cinttypes>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+static constexpr uint32 ARCID = CompileFourCC("ARC");
+static constexpr uint32 CRAID = CompileFourCC("\0CRA");
+static constexpr uint32 ARCCID = CompileFourCC("ARCC");
+static constexpr uint32 SFHID = CompileFourCC("\0SFH");
+
+// HFS stores 16 byte checksum at the end of every 0x20000 chunk
+static std::string UnwrapHFS(std::string_view data) {
+  constexpr size_t hdrSize = 16;
+  constexpr size_t chunkSize = 0x20000;
+  constexpr size_t chunkData = chunkSize - 16;
+
+  if (data.size() < hdrSize) {
+    throw std::runtime_error("Truncated HFS header.");
+  }
+
+  uint32 fileSize;
+  memcpy(&fileSize, data.data() + 8, sizeof(fileSize));
+  fileSize = std::byteswap(fileSize);
+
+  data.remove_prefix(hdrSize);
+  std::string retVal;
+  retVal.reserve(fileSize);
+
+  while (retVal.size() < fileSize) {
+    const size_t toCopy = std::min(chunkData, fileSize - retVal.size());
+
+    if (data.size() < toCopy) {
+      throw std::runtime_error("Truncated HFS data.");
+    }
+
+    retVal.append(data.data(), toCopy);
+    data.remove_prefix(std::min(data.size(), chunkSize));
+  }
+
+  return retVal;
+}
+
+static constexpr char NormalizeChar(char c) {
+  if (c == '/') {
+    return '\\';
+  }
+
+  if (c >= 'A' && c <= 'Z') {
+    return c + ('a' - 'A');
+  }
+
+  return c;
+}
+
+// CRC32 of normalized path
+static uint32 NameHash(std::string_view name) {
+  uint32 retVal = 0xFFFFFFFF;
+
+  for (char c : name) {
+    const uint8 index = (retVal ^ uint8(NormalizeChar(c))) & 0xFF;
+    retVal = (retVal >> 8) ^ revil::detail::CRC32_BOX[index];
+  }
+
+  return retVal;
+}
+
+static bool NameEqual(std::string_view name0, std::string_view name1) {
+  return std::ranges::equal(name0, name1, {}, NormalizeChar, NormalizeChar);
+}
+
+static constexpr uint32 INDEXID = CompileFourCC("RIDX");
+
+struct ARCIndexHeader {
+  uint32 id = INDEXID;
+  uint32 version = 1;
+  uint64 archiveSize;
+  int64 archiveTime;
+  uint32 numFiles;
+  uint32 numSlots;
+};
+
+// Open addressing table of name hashes, same layout as ExtensionResolver
+struct ARCNameIndex {
+  static constexpr uint32 EMPTY = 0xFFFFFFFF;
+
+  struct Slot {
+    uint32 hash = 0;
+    uint32 index = EMPTY;
+  };
+
+  std::vector<Slot> slots;
+  size_t mask = 0;
+  uint32 shift = 0;
+
+  void Resize(size_t numSlots) {
+    slots.resize(numSlots);
+    mask = slots.size() - 1;
+    shift = 32 - std::countr_zero(slots.size());
+  }
+
+  void Build(const revil::ARCEntries &entries) {
+    const uint32 numBits = std::bit_width(entries.size() * 2);
+    Resize(size_t(1) << std::max(numBits, 1U));
+
+    for (uint32 e = 0; e < entries.size(); e++) {
+      const uint32 hash = NameHash(entries[e].fileName);
+
+      for (size_t i = Index(hash);; i = (i + 1) & mask) {
+        if (slots[i].index == EMPTY) {
+          slots[i] = {hash, e};
+          break;
+        }
+      }
+    }
+  }
+
+  // Calls pred for every entry with the same name, in archive order
+  template <class Pred>
+  size_t Find(const revil::ARCEntries &entries, std::string_view fileName,
+              Pred &&pred) const {
+    const uint32 hash = NameHash(fileName);
+
+    for (size_t i = Index(hash); slots[i].index != EMPTY; i = (i + 1) & mask) {
+      const Slot &slot = slots[i];
+
+      if (slot.hash == hash) {
+        const revil::ARCEntry entry = entries[slot.index];
+
+        if (NameEqual(entry.fileName, fileName) && pred(entry)) {
+          return slot.index;
+        }
+      }
+    }
+
+    return entries.size();
+  }
+
+  size_t Index(uint32 hash) const { return (hash * 0x9E3779B1) >> shift; }
+};
+
+class revil::ARCArchiveImpl {
+public:
+  MappedFile file;
+  std::string path;
+  std::string title;
+  std::string unwrapped;
+  std::string decryptedTOC;
+  std::string_view data;
+  ARCEntries entries;
+  BlowfishEncoder enc;
+  Platform platform = Platform::Win32;
+  uint16 version = 0;
+  uint32 lzxWindowBits = 0;
+  bool encrypted = false;
+  ARCNameIndex nameIndex;
+  std::once_flag nameIndexBuilt;
+  std::optional<ExtensionResolver> resolver;
+  std::once_flag resolverBuilt;
+
+  ARCArchiveImpl(const std::string &path_, std::string_view title_,
+                 Platform platform_)
+      : file(path_), path(path_), title(title_), data(file.Data()) {
+    auto ReadU32 = [&](size_t offset) {
+      if (data.size() < offset + 4) {
+        throw std::runtime_error("Truncated ARC header.");
+      }
+
+      uint32 value;
+      memcpy(&value, data.data() + offset, sizeof(value));
+      return value;
+    };
+
+    uint32 id = ReadU32(0);
+
+    if (id == SFHID) {
+      unwrapped = UnwrapHFS(data);
+      data = unwrapped;
+      id = ReadU32(0);
+    }
+
+    if (id != ARCID && id != CRAID && id != ARCCID) {
+      throw es::InvalidHeaderError(id);
+    }
+
+    const bool bigEndian = id == CRAID;
+    platform = bigEndian ? Platform::PS3 : Platform::Win32;
+
+    if (platform_ != Platform::Auto) {
+      if (PlatformInfo(platform_).bigEndian != bigEndian) {
+        throw std::runtime_error("Platform endianness mismatch.");
+      }
+
+      platform = platform_;
+    }
+
+    uint32 versionAndCount = ReadU32(4);
+    const uint32 lzxTag = ReadU32(8);
+
+    if (bigEndian) {
+      versionAndCount = std::byteswap(versionAndCount);
+      version = versionAndCount >> 16;
+    } else {
+      version = versionAndCount;
+    }
+
+    const size_t numFiles = bigEndian ? versionAndCount & 0xFFFF
+                                      : versionAndCount >> 16;
+    const ArcSupport *arcSupport =
+        title.empty() ? nullptr : &GetTitleSupport(title, platform)->arc;
+    const bool extended = arcSupport && arcSupport->extendedFilePath;
+    const size_t nameSize = extended ? 0x80 : 0x40;
+    size_t tocOffset = 8;
+
+    if (!extended && id != ARCCID && !lzxTag) {
+      // Padded header
+      tocOffset = 12;
+    }
+
+    if (version == 0x11 && lzxTag && !extended) {
+      lzxWindowBits = id == ARCID ? 17 : 15;
+    }
+
+    const size_t tocSize = numFiles * (nameSize + 16);
+
+    if (data.size() < tocOffset + tocSize) {
+      throw std::runtime_error("Truncated ARC table of contents.");
+    }
+
+    const char *toc = data.data() + tocOffset;
+
+    if (id == ARCCID) {
+      if (!arcSupport || arcSupport->blowfishKey.empty()) {
+        throw std::runtime_error(
+            "Encrypted archives not supported for this title");
+      }
+
+      enc.SetKey(arcSupport->blowfishKey);
+      decryptedTOC.assign(toc, tocSize);
+      enc.Decode(decryptedTOC.data(), tocSize);
+      toc = decryptedTOC.data();
+      encrypted = true;
+    }
+
+    entries = ARCEntries(toc, numFiles, nameSize, bigEndian);
+  }
+
+  const ARCNameIndex &NameIndex() {
+    std::call_once(nameIndexBuilt, [&] { nameIndex.Build(entries); });
+    return nameIndex;
+  }
+
+  const ExtensionResolver &Resolver() {
+    std::call_once(resolverBuilt, [&] { resolver.emplace(title, platform); });
+    return *resolver;
+  }
+
+  ARCIndexHeader IndexHeader() const {
+    ARCIndexHeader hdr;
+    hdr.archiveSize = file.Data().size();
+    hdr.archiveTime =
+        std::filesystem::last_write_time(path).time_since_epoch().count();
+    hdr.numFiles = entries.size();
+    hdr.numSlots = nameIndex.slots.size();
+    return hdr;
+  }
+
+  std::string_view RawData(size_t index) const {
+    const ARCEntry entry = entries[index];
+
+    if (size_t(entry.offset) + entry.compressedSize > data.size()) {
+      throw std::runtime_error("ARC entry is out of bounds.");
+    }
+
+    return data.substr(entry.offset, entry.compressedSize);
+  }
+};
+
+namespace revil {
+ARCArchive::ARCArchive(const std::string &path, std::string_view title,
+                       Platform platform)
+    : pi(std::make_unique<ARCArchiveImpl>(path, title, platform)) {}
+ARCArchive::ARCArchive(ARCArchive &&) = default;
+ARCArchive::~ARCArchive() = default;
+
+const ARCEntries &ARCArchive::Entries() const { return pi->entries; }
+
+uint16 ARCArchive::Version() const { return pi->version; }
+
+Platform ARCArchive::GetPlatform() const { return pi->platform; }
+
+size_t ARCArchive::Find(std::string_view fileName) const {
+  return pi->NameIndex().Find(pi->entries, fileName,
+                              [](const ARCEntry &) { return true; });
+}
+
+size_t ARCArchive::Find(std::string_view fileName, uint32 typeHash) const {
+  return pi->NameIndex().Find(
+      pi->entries, fileName,
+      [&](const ARCEntry &e) { return e.typeHash == typeHash; });
+}
+
+size_t ARCArchive::FindPath(std::string_view path) const {
+  const size_t extPos = path.find_last_of('.');
+
+  if (extPos == path.npos) {
+    return pi->entries.size();
+  }
+
+  const std::string_view extension = path.substr(extPos + 1);
+  const ExtensionResolver &resolver = pi->Resolver();
+
+  return pi->NameIndex().Find(
+      pi->entries, path.substr(0, extPos), [&](const ARCEntry &e) {
+        std::string_view ext = resolver(e.typeHash);
+
+        if (!ext.empty()) {
+          return ext == extension;
+        }
+
+        char buffer[0x10]{};
+        snprintf(buffer, sizeof(buffer), "%.8" PRIX32, e.typeHash);
+        return extension == buffer;
+      });
+}
+
+bool ARCArchive::LoadIndex(const std::string &indexPath) {
+  std::ifstream str(indexPath, std::ios::binary);
+
+  if (!str) {
+    return false;
+  }
+
+  ARCIndexHeader hdr;
+  ARCIndexHeader expected = pi->IndexHeader();
+
+  if (!str.read(reinterpret_cast<char *>(&hdr), sizeof(hdr)) ||
+      hdr.id != INDEXID || hdr.version != expected.version ||
+      hdr.archiveSize != expected.archiveSize ||
+      hdr.archiveTime != expected.archiveTime ||
+      hdr.numFiles != expected.numFiles || !std::has_single_bit(hdr.numSlots) ||
+      hdr.numSlots <= hdr.numFiles || hdr.numSlots < 2) {
+    return false;
+  }
+
+  ARCNameIndex index;
+  index.Resize(hdr.numSlots);
+
+  if (!str.read(reinterpret_cast<char *>(index.slots.data()),
+                index.slots.size() * sizeof(ARCNameIndex::Slot))) {
+    return false;
+  }
+
+  size_t numEmpty = 0;
+
+  for (auto &slot : index.slots) {
+    if (slot.index == ARCNameIndex::EMPTY) {
+      numEmpty++;
+    } else if (slot.index >= hdr.numFiles) {
+      return false;
+    }
+  }
+
+  // Probing stops only at empty slot
+  if (!numEmpty) {
+    return false;
+  }
+
+  // Index built by earlier lookup is kept, it might be in use
+  bool loaded = false;
+  std::call_once(pi->nameIndexBuilt, [&] {
+    pi->nameIndex = std::move(index);
+    loaded = true;
+  });
+
+  return loaded;
+}
+
+void ARCArchive::SaveIndex(const std::string &indexPath) const {
+  const ARCNameIndex &index = pi->NameIndex();
+  const ARCIndexHeader hdr = pi->IndexHeader();
+  std::ofstream str(indexPath, std::ios::binary);
+
+  if (!str) {
+    throw std::runtime_error("Cannot create file: " + indexPath);
+  }
+
+  str.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+  str.write(reinterpret_cast<const char *>(index.slots.data()),
+            index.slots.size() * sizeof(ARCNameIndex::Slot));
+}
+
+std::string_view ARCArchive::RawData(size_t index) const {
+  return pi->RawData(index);
+}
+
+size_t ARCArchive::Read(size_t index, std::span<char> out,
+                        ARCCodec &codec) const {
+  if (index >= pi->entries.size()) {
+    throw std::out_of_range("ARC entry index out of range.");
+  }
+
+  const ARCEntry entry = pi->entries[index];
+
+  if (out.size() < entry.uncompressedSize) {
+    throw std::runtime_error("Output buffer is too small.");
+  }
+
+  std::string_view inData = RawData(index);
+
+  if (pi->encrypted) {
+    static thread_local std::string decrypted;
+    decrypted.assign(inData);
+    // Encoder is copied, concurrent reads share keyed original
+    BlowfishEncoder enc = pi->enc;
+    enc.Decode(decrypted.data(), decrypted.size());
+    inData = decrypted;
+  }
+
+  if (!entry.uncompressedSize) {
+    return 0;
+  }
+
+  // PS3 stores raw data when sizes match
+  if (PlatformInfo(pi->platform).bigEndian &&
+      entry.compressedSize == entry.uncompressedSize) {
+    memcpy(out.data(), inData.data(), inData.size());
+    return inData.size();
+  }
+
+  if (pi->lzxWindowBits) {
+    return codec.InflateLZX(inData, out.subspan(0, entry.uncompressedSize),
+                            pi->lzxWindowBits);
+  }
+
+  return codec.Inflate(inData, out);
+}
+
+size_t ARCArchive::Read(std::string_view fileName, std::span<char> out,
+                        ARCCodec &codec) const {
+  const size_t index = Find(fileName);
+
+  if (index >= pi->entries.size()) {
+    throw std::runtime_error("ARC entry not found: " + std::string(fileName));
+  }
+
+  return Read(index, out, codec);
+}
+} // namespace revil
@@ -0,0 +1,235 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "revil/arc.hpp"
+#include "zlib.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "lzx.h"
+#include "mspack.h"
+
+#pragma region XMemDecompress
+
+struct mspack_file {
+  uint8 *buffer;
+  uint32 bufferSize;
+  uint32 position;
+  uint32 rest;
+};
+
+// https://github.com/gildor2/UEViewer/blob/master/Unreal/UnCoreCompression.cpp#L90
+static int mspack_read(mspack_file *file, void *buffer, int bytes) {
+  if (!file->rest) {
+    // read block header
+    if (file->buffer[file->position] == 0xFF) {
+      // [0]   = FF
+      // [1,2] = uncompressed block size
+      // [3,4] = compressed block size
+      file->rest = (file->buffer[file->position + 3] << 8) |
+                   file->buffer[file->position + 4];
+      file->position += 5;
+    } else {
+      // [0,1] = compressed size
+      file->rest = (file->buffer[file->position + 0] << 8) |
+                   file->buffer[file->position + 1];
+      file->position += 2;
+    }
+
+    if (file->rest > file->bufferSize - file->position) {
+      file->rest = file->bufferSize - file->position;
+    }
+  }
+
+  if (bytes > file->rest) {
+    bytes = file->rest;
+  }
+
+  if (bytes <= 0) {
+    return 0;
+  }
+
+  memcpy(buffer, file->buffer + file->position, bytes);
+  file->position += bytes;
+  file->rest -= bytes;
+
+  return bytes;
+}
+
+static int mspack_write(mspack_file *file, void *buffer, int bytes) {
+  if (bytes <= 0) {
+    return 0;
+  }
+
+  memcpy(file->buffer + file->position, buffer, bytes);
+  file->position += bytes;
+  return bytes;
+}
+
+static mspack_system mspackSystem{
+    nullptr,                                                     // open
+    nullptr,                                                     // close
+    mspack_read,                                                 // read
+    mspack_write,                                                // write
+    nullptr,                                                     // seek
+    nullptr,                                                     // tell
+    nullptr,                                                     // message
+    [](mspack_system *, size_t bytes) { return malloc(bytes); }, // alloc
+    free,                                                        // free
+    [](void *src, void *dst, size_t bytes) { memcpy(dst, src, bytes); }, // copy
+};
+
+static size_t DecompressLZX(const char *inBuffer, uint32 compressedSize,
+                            char *outBuffer, uint32 uncompressedSize,
+                            uint32 wBits) {
+  mspack_file inStream{};
+  mspack_file outStream{};
+  inStream.buffer = reinterpret_cast<uint8 *>(const_cast<char *>(inBuffer));
+  inStream.bufferSize = compressedSize;
+  outStream.buffer = reinterpret_cast<uint8 *>(outBuffer);
+  outStream.bufferSize = uncompressedSize;
+
+  lzxd_stream *lzxd = lzxd_init(&mspackSystem, &inStream, &outStream, wBits, 0,
+                                1 << wBits, uncompressedSize, false);
+
+  if (!lzxd) {
+    throw std::runtime_error("Failed to initialize LZX stream.");
+  }
+
+  int retVal = lzxd_decompress(lzxd, uncompressedSize);
+  lzxd_free(lzxd);
+
+  if (retVal != MSPACK_ERR_OK) {
+    throw std::runtime_error("LZX decompression error " +
+                             std::to_string(retVal));
+  }
+
+  return outStream.position;
+}
+
+#pragma endregion
+
+class revil::ARCCodecImpl {
+public:
+  z_stream inflateStream{};
+  z_stream deflateStream{};
+  bool inflateReady = false;
+  uint32 deflateWindowBits = 0;
+
+  ARCCodecImpl() = default;
+  ARCCodecImpl(const ARCCodecImpl &) = delete;
+
+  ~ARCCodecImpl() {
+    if (inflateReady) {
+      inflateEnd(&inflateStream);
+    }
+
+    if (deflateWindowBits) {
+      deflateEnd(&deflateStream);
+    }
+  }
+
+  z_stream &InflateStream() {
+    if (inflateReady) {
+      inflateReset(&inflateStream);
+    } else if (inflateInit(&inflateStream) != Z_OK) {
+      throw std::runtime_error("Failed to initialize inflate stream.");
+    } else {
+      inflateReady = true;
+    }
+
+    return inflateStream;
+  }
+
+  // Window size cannot be changed by deflateReset
+  z_stream &DeflateStream(int level, uint32 windowBits) {
+    if (deflateWindowBits == windowBits) {
+      deflateReset(&deflateStream);
+
+      if (deflateParams(&deflateStream, level, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("Failed to set deflate parameters.");
+      }
+
+      return deflateStream;
+    }
+
+    if (deflateWindowBits) {
+      deflateEnd(&deflateStream);
+      deflateWindowBits = 0;
+    }
+
+    if (deflateInit2(&deflateStream, level, Z_DEFLATED, windowBits, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw std::runtime_error("Failed to initialize deflate stream.");
+    }
+
+    deflateWindowBits = windowBits;
+
+    return deflateStream;
+  }
+};
+
+namespace revil {
+ARCCodec::ARCCodec() : pi(std::make_unique<ARCCodecImpl>()) {}
+ARCCodec::ARCCodec(ARCCodec &&) = default;
+ARCCodec::~ARCCodec() = default;
+
+size_t ARCCodec::Inflate(std::string_view in, std::span<char> out) {
+  z_stream &stream = pi->InflateStream();
+  stream.avail_in = in.size();
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in.data()));
+  stream.avail_out = out.size();
+  stream.next_out = reinterpret_cast<Bytef *>(out.data());
+  int state = inflate(&stream, Z_FINISH);
+
+  if (state < 0) {
+    throw std::runtime_error(stream.msg ? stream.msg : "Inflate error.");
+  }
+
+  return stream.total_out;
+}
+
+size_t ARCCodec::InflateLZX(std::string_view in, std::span<char> out,
+                            uint32 windowBits) {
+  return DecompressLZX(in.data(), in.size(), out.data(), out.size(),
+                       windowBits);
+}
+
+size_t ARCCodec::Deflate(std::string_view in, std::span<char> out, int level,
+                         uint32 windowBits) {
+  z_stream &stream = pi->DeflateStream(level, windowBits);
+  stream.avail_in = in.size();
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in.data()));
+  stream.avail_out = out.size();
+  stream.next_out = reinterpret_cast<Bytef *>(out.data());
+  int state = deflate(&stream, Z_FINISH);
+
+  if (state != Z_STREAM_END) {
+    throw std::runtime_error("Compression Error!");
+  }
+
+  return stream.total_out;
+}
+
+size_t ARCCodec::DeflateBound(size_t inSize) { return compressBound(inSize); }
+
+ARCCodec &ARCCodec::ThreadContext() {
+  static thread_local ARCCodec codec;
+  return codec;
+}
+} // namespace revil
@@ -0,0 +1,86 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "arc.hpp"
+#include "revil/arc.hpp"
+#include "spike/io/binwritter_stream.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace revil {
+size_t WriteARCHeader(BinWritterRef_e wr,
+                      std::span<const ARCWriteEntry> entries,
+                      const ArcSupport &support, Platform platform) {
+  if (entries.size() > std::numeric_limits<decltype(ARC::numFiles)>::max()) {
+    throw std::runtime_error("Filecount exceeded archive limit.");
+  }
+
+  wr.SwapEndian(PlatformInfo(platform).bigEndian);
+
+  ARCBase arc;
+  arc.numFiles = entries.size();
+  arc.version = support.version;
+
+  if (arc.version < 10 || support.xmemOnly) {
+    wr.Write(arc);
+  } else {
+    ARC arcEx{arc};
+    wr.Write(arcEx);
+  }
+
+  const size_t recordSize = support.extendedFilePath ? sizeof(ARCExtendedFile)
+                                                     : sizeof(ARCFile);
+  const size_t dataOffset = wr.Tell() + entries.size() * recordSize;
+  size_t curOffset = dataOffset;
+
+  auto WriteFile = [&](auto cFile, const ARCWriteEntry &f) {
+    if (f.fileName.size() > sizeof(cFile.fileName)) {
+      throw std::runtime_error("Filename too large: " +
+                               std::string(f.fileName));
+    }
+
+    if (curOffset + f.compressedSize > std::numeric_limits<uint32>::max()) {
+      throw std::runtime_error("Archive size exceeded 4GB limit.");
+    }
+
+    cFile.offset = curOffset;
+    cFile.typeHash = f.typeHash;
+    memcpy(cFile.fileName, f.fileName.data(), f.fileName.size());
+    cFile.uncompressedSize = f.uncompressedSize;
+    cFile.compressedSize = f.compressedSize;
+
+    if (platform == Platform::Win32) {
+      std::replace(std::begin(cFile.fileName), std::end(cFile.fileName), '/',
+                   '\\');
+    }
+
+    wr.Write(cFile);
+    curOffset += f.compressedSize;
+  };
+
+  for (auto &f : entries) {
+    if (support.extendedFilePath) {
+      WriteFile(ARCExtendedFile{}, f);
+    } else {
+      WriteFile(ARCFile{}, f);
+    }
+  }
+
+  return dataOffset;
+}
+} // namespace revil
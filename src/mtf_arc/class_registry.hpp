@@ -0,0 +1,72 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "../hash.hpp"
+#include "revil/platform.hpp"
+#include <algorithm>
+#include <span>
+
+struct MtClass {
+  uint32 hash;
+  std::string_view extension;
+  std::string_view name;
+};
+
+// Flat registry sorted by hash
+using MtClassRegistry = std::span<const MtClass>;
+
+constexpr MtClass MakeHashV1(std::string_view ext, std::string_view name) {
+  return {revil::MTHashV1Const(name), ext, name};
+}
+
+constexpr MtClass MakeHashV2(std::string_view ext, std::string_view name) {
+  return {revil::MTHashV2Const(name), ext, name};
+}
+
+constexpr MtClass MakeHashV1(std::string_view name) {
+  return MakeHashV1({}, name);
+}
+
+constexpr MtClass MakeHashV2(std::string_view name) {
+  return MakeHashV2({}, name);
+}
+
+template <size_t N>
+constexpr std::array<MtClass, N> MakeClassRegistry(MtClass (&&items)[N]) {
+  std::array<MtClass, N> retVal = std::to_array(std::move(items));
+  std::ranges::sort(retVal, {}, &MtClass::hash);
+  return retVal;
+}
+
+constexpr bool IsUnique(MtClassRegistry registry) {
+  return std::ranges::adjacent_find(registry, {}, &MtClass::hash) ==
+         registry.end();
+}
+
+inline const MtClass *FindClass(MtClassRegistry registry, uint32 hash) {
+  auto found = std::ranges::lower_bound(registry, hash, {}, &MtClass::hash);
+
+  if (found == registry.end() || found->hash != hash) {
+    return nullptr;
+  }
+
+  return &*found;
+}
+
+// Lookup class from platform registry first, then from base registry
+const MtClass *GetClass(uint32 hash, revil::Platform platform);
@@ -15,20 +15,12 @@
     along with this program.If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "class_registry.hpp"
 #include "revil/hashreg.hpp"
-#include <map>
 
 using revil::Platform;
 
-static auto MakeHashV1(std::string_view name) {
-  return std::make_pair(revil::MTHashV1(name), name);
-}
-
-static auto MakeHashV2(std::string_view name) {
-  return std::make_pair(revil::MTHashV2(name), name);
-}
-
-static const std::map<uint32, std::string_view> classNames{
+static constexpr auto classNames = MakeClassRegistry({
     MakeHashV1("MtArray"),
     MakeHashV1("nodeData"),
     MakeHashV1("nodeHead"),
@@ -71,7 +63,6 @@ static const std::map<uint32, std::string_view> classNames{
     MakeHashV2("cAIPlanFilterDataPostBOT"),
     MakeHashV2("cAIPlanFilterDefenceAkEgg"),
     MakeHashV2("cAIPlanFilterDevelop"),
-    MakeHashV2("cAIPlanFilterDevelop"),
     MakeHashV2("cAIPlanFilterDir"),
     MakeHashV2("cAIPlanFilterDistans"),
     MakeHashV2("cAIPlanFilterEpisode"),
@@ -84,7 +75,6 @@ static const std::map<uint32, std::string_view> classNames{
     MakeHashV2("cAIPlanFilterCharIsXXX"),
     MakeHashV2("cAIPlanFilterCharStatus"),
     MakeHashV2("cAIPlanFilterIsAction"),
-    MakeHashV2("cAIPlanFilterIsAction"),
     MakeHashV2("cAIPlanFilterIsPlayerAuto"),
     MakeHashV2("cAIPlanFilterMessagePickUp"),
     MakeHashV2("cAIPlanFilterNetRecieveDataPost"),
@@ -258,24 +248,18 @@ static const std::map<uint32, std::string_view> classNames{
     MakeHashV2("rTexDetailEdit::DetailParam"),
     MakeHashV2("rThinkPlanAI::cItemPlanInfo"),
     MakeHashV2("rThinkPlanAI::cU32"),
-};
-
-using pair_type = std::pair<std::string_view, std::string_view>;
+});
 
-std::pair<uint32 const, pair_type> GetPair(uint32 hash, Platform platform);
+static_assert(IsUnique(classNames));
 
 namespace revil {
 std::string_view GetClassName(uint32 hash, Platform platform) {
-  auto pair = GetPair(hash, platform);
-
-  if (pair.first) {
-    return pair.second.second;
+  if (auto found = GetClass(hash, platform); found) {
+    return found->name;
   }
 
-  auto found = classNames.find(hash);
-
-  if (!es::IsEnd(classNames, found)) {
-    return found->second;
+  if (auto found = FindClass(classNames, hash); found) {
+    return found->name;
   }
 
   return {};
@@ -15,20 +15,12 @@
     along with this program.If not, see <https://www.gnu.org/licenses/>.
 */
 
-#include "revil/hashreg.hpp"
+#include "class_registry.hpp"
 #include "ext_base.hpp"
+#include "revil/hashreg.hpp"
+#include <bit>
 
-using pair_type = std::pair<std::string_view, std::string_view>;
-
-static auto MakeHashV1(std::string_view ext, std::string_view name) {
-  return std::make_pair(revil::MTHashV1(name), std::make_pair(ext, name));
-}
-
-static auto MakeHashV2(std::string_view ext, std::string_view name) {
-  return std::make_pair(revil::MTHashV2(name), std::make_pair(ext, name));
-}
-
-static const std::map<uint32, pair_type> extensions{
+static constexpr auto extensions = MakeClassRegistry({
     MakeHashV1("ahl", "rAreaHitLayout"),
     MakeHashV1("anm", "rSprAnm"),
     MakeHashV1("arc", "rArchive"),
@@ -1844,21 +1836,21 @@ static const std::map<uint32, pair_type> extensions{
     MakeHashV2("xsew", "rSoundSourceMSADPCM"),
     MakeHashV2("zei", "rItemZeny"),
     MakeHashV2("zon", "rZone"),
-};
+});
 
-static decltype(extensions) extensionsPS3{
+static constexpr auto extensionsPS3 = MakeClassRegistry({
     MakeHashV2("rev_ps3", "rSoundReverb"),
     MakeHashV1("at3", "rSoundSourceMusic"),
     MakeHashV2("rev_ps3", "rPlanetReverb"),
     MakeHashV1("rev_ps3", "rReverb"),
     MakeHashV2("at3", "rSoundSourceMusic"),
-};
+});
 
-static decltype(extensions) extensionsCAFE{
+static constexpr auto extensionsCAFE = MakeClassRegistry({
     MakeHashV2("revr_cafe", "rSoundReverb"),
-};
+});
 
-static decltype(extensions) extensionsN3DS{
+static constexpr auto extensionsN3DS = MakeClassRegistry({
     /**/ //
     MakeHashV2("arg", "rArrange"),
     MakeHashV2("lyt", "rLayout"),
@@ -1866,16 +1858,16 @@ static decltype(extensions) extensionsN3DS{
     MakeHashV2("equr", "rSoundEQ"),
     MakeHashV2("mix", "rItemMix"),
     MakeHashV2("atp", "rAttackParam"),
-};
+});
 
-static decltype(extensions) extensionsNSW{
+static constexpr auto extensionsNSW = MakeClassRegistry({
     MakeHashV2("stqr", "rSoundStreamRequest"),
     MakeHashV2("srqr", "rSoundRequest"),
     MakeHashV2("revr", "rSoundReverb"),
     MakeHashV2("adpcm", "rSoundSourceADPCM"),
-};
+});
 
-static decltype(extensions) extensionsAND{
+static constexpr auto extensionsAND = MakeClassRegistry({
     /**/ //
     MakeHashV2("equr", "rSoundEQ"),
     MakeHashV2("lyt", "rLayout"),
@@ -1889,49 +1881,55 @@ static decltype(extensions) extensionsAND{
     MakeHashV2("sew", "rSoundSourceADPCM"),
     MakeHashV2("srqr", "rSoundRequest"),
     MakeHashV2("stqr", "rSoundStreamRequest"),
-};
+});
 
-static decltype(extensions) extensionsIOS{
+static constexpr auto extensionsIOS = MakeClassRegistry({
     /**/ //
     MakeHashV2("lyt", "rLayout"),
     MakeHashV2("revr_appl", "rSoundReverb"),
     MakeHashV2("equr", "rSoundEQ"),
     MakeHashV2("mix", "rItemMix"),
     MakeHashV2("mfx", "rShader"),
-};
-
-static const std::map<Platform, decltype(extensions) *> extensionSlots{
-    /**/ //
-    {Platform::Auto, &extensions},
-    {Platform::Win32, &extensions},
-    {Platform::PS3, &extensionsPS3},
-    {Platform::CAFE, &extensionsCAFE},
-    {Platform::N3DS, &extensionsN3DS},
-    {Platform::NSW, &extensionsNSW},
-    {Platform::Android, &extensionsAND},
-    {Platform::IOS, &extensionsIOS},
-};
+});
 
-decltype(extensions)::value_type GetPair(uint32 hash, Platform platform) {
-  auto Find = [hash](auto &reg) {
-    auto found = reg.find(hash);
+static_assert(IsUnique(extensions));
+static_assert(IsUnique(extensionsPS3));
+static_assert(IsUnique(extensionsCAFE));
+static_assert(IsUnique(extensionsN3DS));
+static_assert(IsUnique(extensionsNSW));
+static_assert(IsUnique(extensionsAND));
+static_assert(IsUnique(extensionsIOS));
 
-    if (!es::IsEnd(reg, found)) {
-      return *found;
-    }
-
-    return decltype(extensions)::value_type{0, {{}, {}}};
-  };
+static MtClassRegistry GetPlatformRegistry(Platform platform) {
+  switch (platform) {
+  case Platform::Auto:
+  case Platform::Win32:
+    return extensions;
+  case Platform::PS3:
+    return extensionsPS3;
+  case Platform::CAFE:
+    return extensionsCAFE;
+  case Platform::N3DS:
+    return extensionsN3DS;
+  case Platform::NSW:
+    return extensionsNSW;
+  case Platform::Android:
+    return extensionsAND;
+  case Platform::IOS:
+    return extensionsIOS;
+  default:
+    return {};
+  }
+}
 
+const MtClass *GetClass(uint32 hash, Platform platform) {
   if (platform != Platform::Auto) {
-    auto retVal = Find(*extensionSlots.at(platform));
-
-    if (retVal.first) {
-      return retVal;
+    if (auto found = FindClass(GetPlatformRegistry(platform), hash); found) {
+      return found;
     }
   }
 
-  return Find(extensions);
+  return FindClass(extensions, hash);
 }
 
 const MtExtFixupStorage *GetFixups(std::string_view);
@@ -1957,12 +1955,56 @@ std::string_view GetExtension(uint32 hash, std::string_view title,
     }
   }
 
-  auto pair = GetPair(hash, platform);
-
-  if (pair.first) {
-    return pair.second.first;
+  if (auto found = GetClass(hash, platform); found) {
+    return found->extension;
   }
 
   return {};
 }
+
+// Entries are inserted in reverse lookup order, so title fixups override
+// platform classes and platform classes override base classes
+ExtensionResolver::ExtensionResolver(std::string_view title,
+                                     Platform platform) {
+  const MtExtFixupStorage *fixups = title.empty() ? nullptr : GetFixups(title);
+  MtClassRegistry platformRegistry;
+
+  if (platform != Platform::Auto) {
+    platformRegistry = GetPlatformRegistry(platform);
+  }
+
+  const size_t numItems = extensions.size() + platformRegistry.size() +
+                          (fixups ? fixups->size() : 0);
+  const uint32 numBits = std::bit_width(numItems * 2);
+  slots.resize(size_t(1) << numBits);
+  mask = slots.size() - 1;
+  shift = 32 - numBits;
+
+  for (auto &c : extensions) {
+    Insert(c.hash, c.extension);
+  }
+
+  for (auto &c : platformRegistry) {
+    Insert(c.hash, c.extension);
+  }
+
+  if (fixups) {
+    for (auto &[hash, extension] : *fixups) {
+      Insert(hash, extension);
+    }
+  }
+}
+
+void ExtensionResolver::Insert(uint32 hash, std::string_view extension) {
+  for (size_t i = Index(hash);; i = (i + 1) & mask) {
+    Slot &slot = slots[i];
+
+    if (!slot.extension || slot.hash == hash) {
+      slot.hash = hash;
+      slot.extension = extension.data();
+      slot.extensionSize = extension.size();
+      return;
+    }
+  }
+}
 } // namespace revil
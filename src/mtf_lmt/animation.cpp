@@ -83,6 +83,26 @@ bool IsX64CompatibleAnimationClass(BinReaderRef_e rd,
              }());
 }
 
+LMTBlockInfo ReadBlockInfo(const char *data, LMTConstructorPropertiesBase props,
+                           bool swapEndian) {
+  const clgen::Animation::Interface interface(
+      const_cast<char *>(data),
+      clgen::LayoutLookup{static_cast<uint8>(props.version),
+                          props.arch == LMTArchType::X64, false});
+  LMTBlockInfo retVal;
+  retVal.numTracks = interface.NumTracks();
+  retVal.numFrames = interface.NumFrames();
+  retVal.loopFrame = interface.LoopFrame();
+
+  if (swapEndian) {
+    FByteswapper(retVal.numTracks);
+    FByteswapper(retVal.numFrames);
+    FByteswapper(retVal.loopFrame);
+  }
+
+  return retVal;
+}
+
 struct LMTAnimationMidInterface : LMTAnimationInterface {
   clgen::Animation::Interface interface;
   std::unique_ptr<LMTAnimationEvent> events;
@@ -127,7 +147,7 @@ void ProcessClass(LMTAnimationMidInterface &item,
                   LMTConstructorProperties flags) {
   size_t trackStride = 0;
 
-  if (item.interface.TracksPtr().Check(flags.ptrStore)) {
+  if (!flags.fixups.Insert(item.interface.TracksPtr().data)) {
     return;
   }
 
@@ -135,11 +155,11 @@ void ProcessClass(LMTAnimationMidInterface &item,
     clgen::EndianSwap(item.interface);
   }
 
-  item.interface.TracksPtr().Fixup(flags.base, flags.ptrStore);
+  flags.fixups.Fixup(item.interface.TracksPtr(), flags.base);
 
   if (item.interface.LayoutVersion() >= LMT66) {
-    item.interface.EventsPtr().Fixup(flags.base, flags.ptrStore);
-    item.interface.FloatsPtr().Fixup(flags.base, flags.ptrStore);
+    flags.fixups.Fixup(item.interface.EventsPtr(), flags.base);
+    flags.fixups.Fixup(item.interface.FloatsPtr(), flags.base);
     auto events = item.interface.EventsLMT66();
     if (events.data) {
       flags.dataStart = events.data;
@@ -20,6 +20,10 @@
 
 using LMTTracks = uni::PolyVectorList<uni::MotionTrack, LMTTrack>;
 
+// Reads header fields only, data is not modified
+LMTBlockInfo ReadBlockInfo(const char *data, LMTConstructorPropertiesBase props,
+                           bool swapEndian);
+
 struct LMTAnimationInterface : LMTAnimation, LMTTracks {
   std::unique_ptr<std::string> standAloneHolder;
   virtual bool Is64bit() const = 0;
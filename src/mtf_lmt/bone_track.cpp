@@ -20,6 +20,7 @@
 #include "pugixml.hpp"
 #include "spike/reflect/reflector_xml.hpp"
 #include "spike/uni/deleter_hybrid.hpp"
+#include <algorithm>
 
 MAKE_ENUM(ENUMSCOPE(class TrackType_er
                     : uint8, TrackType_er),
@@ -76,6 +77,29 @@ int32 LMTTrackInterface::GetFrame(size_t frame) const {
 }
 
 void LMTTrackInterface::GetValue(Vector4A16 &out, float time) const {
+  LMTTrackCursor cursor;
+  GetValue(out, time, cursor);
+}
+
+size_t FindKey(std::span<const int16> frames, int32 frame,
+               LMTTrackCursor &cursor) {
+  static constexpr size_t MAX_STEPS = 4;
+  size_t f = cursor.frame;
+
+  if (f > 0 && f < frames.size() && frames[f - 1] <= frame) {
+    for (size_t s = 0; s < MAX_STEPS; s++, f++) {
+      if (frames[f] > frame) {
+        return cursor.frame = f;
+      }
+    }
+  }
+
+  auto found = std::upper_bound(std::next(frames.begin()), frames.end(), frame);
+  return cursor.frame = std::distance(frames.begin(), found);
+}
+
+void LMTTrackInterface::GetValue(Vector4A16 &out, float time,
+                                 LMTTrackCursor &cursor) const {
   float frameDelta = time * frameRate;
   int32 frame = static_cast<int32>(frameDelta);
   const size_t numCtrFrames = controller->NumFrames();
@@ -107,23 +131,60 @@ void LMTTrackInterface::GetValue(Vector4A16 &out, float time) const {
     }
   }
 
-  const int32 maxFrame = controller->GetFrame(numCtrFrames - 1);
+  const std::span<const int16> frames = controller->Frames();
+  const int32 maxFrame = frames.back();
 
   if (frame >= maxFrame) {
     Evaluate(out, numCtrFrames - 1);
   } else {
-    for (size_t f = 1; f < numCtrFrames; f++) {
-      int32 cFrame = controller->GetFrame(f);
+    const size_t f = FindKey(frames, frame, cursor);
+    const float boundFrame = static_cast<float>(frames[f]);
+    const float prevFrame = static_cast<float>(frames[f - 1]);
 
-      if (cFrame > frame) {
-        const float boundFrame = static_cast<float>(cFrame);
-        const float prevFrame = static_cast<float>(controller->GetFrame(f - 1));
+    frameDelta = (prevFrame - frameDelta) / (prevFrame - boundFrame);
 
-        frameDelta = (prevFrame - frameDelta) / (prevFrame - boundFrame);
+    controller->Interpolate(out, f - 1, frameDelta, minMax);
+  }
+}
 
-        controller->Interpolate(out, f - 1, frameDelta, minMax);
-        break;
-      }
+void LMTTrackInterface::GetValues(std::span<Vector4A16> out,
+                                  std::span<const float> times) const {
+  const size_t numCtrFrames = controller->NumFrames();
+
+  if (!numCtrFrames) {
+    if (useRefFrame) {
+      std::fill_n(out.begin(), times.size(), GetRefData());
+    }
+
+    return;
+  }
+
+  // First frame is blended from reference data, keys start on second frame
+  const bool refStart = useRefFrame && loopFrame < 1;
+  Vector4A16 lastValue;
+  Evaluate(lastValue, numCtrFrames - 1);
+  controller->Sample(out, times, frameRate, refStart ? -1 : 0, minMax,
+                     lastValue);
+
+  if (!refStart) {
+    return;
+  }
+
+  const Vector4A16 refData = GetRefData();
+  Vector4A16 firstValue;
+  Evaluate(firstValue, 0);
+
+  for (size_t i = 0; i < times.size(); i++) {
+    const float frameDelta = times[i] * frameRate;
+
+    if (static_cast<int32>(frameDelta)) {
+      continue;
+    }
+
+    if (frameDelta < 0.0001f) {
+      out[i] = refData;
+    } else {
+      out[i] = refData + (firstValue - refData) * frameDelta;
     }
   }
 }
@@ -258,15 +319,15 @@ struct LMTTrackMidInterface : LMTTrackInterface {
 
 template <>
 void ProcessClass(LMTTrackMidInterface &item, LMTConstructorProperties flags) {
-  if (!item.interface.BufferPtr().Check(flags.ptrStore)) {
+  if (flags.fixups.Insert(item.interface.BufferPtr().data)) {
     if (flags.swapEndian) {
       clgen::EndianSwap(item.interface);
     }
 
-    item.interface.BufferPtr().Fixup(flags.base, flags.ptrStore);
+    flags.fixups.Fixup(item.interface.BufferPtr(), flags.base);
 
     if (item.interface.LayoutVersion() >= LMT56) {
-      item.interface.ExtremesPtr().Fixup(flags.base, flags.ptrStore);
+      flags.fixups.Fixup(item.interface.ExtremesPtr(), flags.base);
 
       if (auto extr = item.interface.Extremes(); extr) {
         if (flags.swapEndian) {
@@ -21,17 +21,16 @@
 #include "spike/reflect/reflector_xml.hpp"
 #include "spike/util/macroLoop.hpp"
 
+#include <charconv>
 #include <cmath>
-#include <sstream>
+#include <cstring>
 #include <unordered_map>
 
-REFLECT(CLASS(Buf_SingleVector3), MEMBER(data));
-REFLECT(CLASS(Buf_LinearVector3), MEMBER(data), MEMBER(additiveFrames));
 REFLECT(CLASS(Buf_HermiteVector3), MEMBER(flags), MEMBER(additiveFrames),
         MEMBER(data));
 
 // https://en.wikipedia.org/wiki/Slerp
-static Vector4A16 slerp(const Vector4A16 &v0, const Vector4A16 &_v1, float t) {
+Vector4A16 slerp(const Vector4A16 &v0, const Vector4A16 &_v1, float t) {
   Vector4A16 v1 = _v1;
   float dot = v0.Dot(v1);
 
@@ -81,81 +80,119 @@ static Vector4A16 bslerp(const Vector4A16 &v0, const Vector4A16 &v1,
   return slerp(additiveLerp(minMax, v0), additiveLerp(minMax, v1), t);
 }
 
-template <class C>
-void AppendToStringRaw(const C *clPtr, std::stringstream &buffer) {
-  const uint8 *rawData = reinterpret_cast<const uint8 *>(clPtr);
-  const size_t hexSize = clPtr->Size() * 2;
-  size_t cBuff = 0;
-
-  for (size_t i = 0; i < hexSize; i++) {
-    bool idk = i & 1;
-    char temp = 0x30 + (idk ? rawData[cBuff++] & 0xf : rawData[cBuff] >> 4);
+static constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
 
-    if (temp > 0x39) {
-      temp += 7;
-    }
+template <class C> char *AppendToStringRaw(const C *clPtr, char *out) {
+  const uint8 *rawData = reinterpret_cast<const uint8 *>(clPtr);
+  const size_t rawSize = clPtr->Size();
 
-    buffer << temp;
+  for (size_t i = 0; i < rawSize; i++) {
+    *out++ = HEX_DIGITS[rawData[i] >> 4];
+    *out++ = HEX_DIGITS[rawData[i] & 0xf];
   }
+
+  return out;
 }
 
 template <class C>
 std::string_view RetreiveFromRawString(C *clPtr, std::string_view buffer) {
   uint8 *rawData = reinterpret_cast<uint8 *>(clPtr);
   const size_t buffSize = clPtr->Size() * 2;
+  const char *cur = buffer.data();
+  const char *end = cur + buffer.size();
   size_t cBuff = 0;
 
-  while (!buffer.empty() && cBuff < buffSize) {
-    const auto cRef = buffer.at(0);
+  for (; cur < end && cBuff < buffSize; cur++) {
+    const char cRef = *cur;
 
     if (cRef < '0' || cRef > 'F' || (cRef > '9' && cRef < 'A')) {
-      buffer.remove_prefix(1);
       continue;
     }
 
     if (!(cBuff & 1)) {
-      rawData[cBuff] = atohLUT[cRef] << 4;
+      rawData[cBuff / 2] = atohLUT[cRef] << 4;
     } else {
-      rawData[cBuff++] |= atohLUT[cRef];
+      rawData[cBuff / 2] |= atohLUT[cRef];
     }
 
-    buffer.remove_prefix(1);
+    cBuff++;
   }
 
   if (cBuff < buffSize) {
     throw std::runtime_error("Raw buffer is too short!");
   }
 
-  return buffer;
+  return {cur, end};
 }
 
 static auto SeekTo(std::string_view buffer, const char T = '\n') {
-  while (!buffer.empty()) {
-    if (buffer.front() == T) {
-      buffer.remove_prefix(1);
-      return buffer;
-    }
+  const size_t found = buffer.find(T);
 
-    buffer.remove_prefix(1);
+  if (found == buffer.npos) {
+    return buffer.substr(buffer.size());
   }
 
-  return buffer;
+  return buffer.substr(found + 1);
 }
 
-size_t Buf_SingleVector3::Size() const { return 12; }
+static char *WriteText(char *out, std::string_view text) {
+  memcpy(out, text.data(), text.size());
+  return out + text.size();
+}
+
+// Shortest representation that parses back to the same value
+template <class T> static char *WriteNumber(char *out, T value) {
+  return std::to_chars(out, out + TEXT_NUMBER_SIZE, value).ptr;
+}
+
+static char *WriteVector(char *out, const Vector &value) {
+  *out++ = '[';
+  out = WriteNumber(out, value.X);
+  out = WriteText(out, ", ");
+  out = WriteNumber(out, value.Y);
+  out = WriteText(out, ", ");
+  out = WriteNumber(out, value.Z);
+  *out++ = ']';
+  return out;
+}
 
-void Buf_SingleVector3::AppendToString(std::stringstream &buffer) const {
-  ReflectorWrap<const Buf_SingleVector3> tRefl(this);
+// Skips whitespace, brackets and separators before number
+template <class T>
+static std::string_view ReadNumber(std::string_view buffer, T &value) {
+  const size_t begin = buffer.find_first_not_of(" \t\r\n[]{},");
 
-  buffer << tRefl.GetReflectedValue(0);
+  if (begin == buffer.npos) {
+    throw std::runtime_error("Unexpected end of key text!");
+  }
+
+  buffer.remove_prefix(begin);
+  const char *end = buffer.data() + buffer.size();
+  auto [ptr, ec] = std::from_chars(buffer.data(), end, value);
+
+  if (ec != std::errc{}) {
+    throw std::runtime_error("Invalid number in key text: " +
+                             std::string(buffer.substr(0, 16)));
+  }
+
+  return {ptr, end};
+}
+
+static std::string_view ReadVector(std::string_view buffer, Vector &value) {
+  buffer = ReadNumber(buffer, value.X);
+  buffer = ReadNumber(buffer, value.Y);
+  buffer = ReadNumber(buffer, value.Z);
+  return SeekTo(buffer, ']');
+}
+
+size_t Buf_SingleVector3::Size() const { return 12; }
+
+char *Buf_SingleVector3::AppendToString(char *out) const {
+  return WriteVector(out, data);
 }
 
 std::string_view
 Buf_SingleVector3::RetreiveFromString(std::string_view buffer) {
-  buffer = es::SkipStartWhitespace(buffer, true);
-
-  ReflectorWrap<Buf_SingleVector3> tRefl(this);
-  tRefl.SetReflectedValue(0, buffer);
+  buffer = ReadVector(buffer, data);
   return SeekTo(buffer);
 }
 
@@ -201,27 +238,19 @@ void Buf_StepRotationQuat3::Interpolate(Vector4A16 &out,
 
 size_t Buf_LinearVector3::Size() const { return 16; }
 
-void Buf_LinearVector3::AppendToString(std::stringstream &buffer) const {
-  ReflectorWrap<const Buf_LinearVector3> tRefl(this);
-
-  buffer << "{ " << tRefl.GetReflectedValue(0) << ", "
-         << tRefl.GetReflectedValue(1) << " }";
+char *Buf_LinearVector3::AppendToString(char *out) const {
+  out = WriteText(out, "{ ");
+  out = WriteVector(out, data);
+  out = WriteText(out, ", ");
+  out = WriteNumber(out, additiveFrames);
+  return WriteText(out, " }");
 }
 
 std::string_view
 Buf_LinearVector3::RetreiveFromString(std::string_view buffer) {
   buffer = SeekTo(buffer, '{');
-  buffer = es::SkipStartWhitespace(buffer, true);
-
-  ReflectorWrap<Buf_LinearVector3> tRefl(this);
-  tRefl.SetReflectedValue(0, buffer);
-
-  buffer = SeekTo(buffer, ']');
-  buffer = SeekTo(buffer, ',');
-  buffer = es::SkipStartWhitespace(buffer, true);
-
-  tRefl.SetReflectedValue(1, buffer);
-
+  buffer = ReadVector(buffer, data);
+  buffer = ReadNumber(buffer, additiveFrames);
   return SeekTo(buffer);
 }
 
@@ -259,51 +288,55 @@ void Buf_LinearVector3::SwapEndian() {
 
 size_t Buf_HermiteVector3::Size() const { return size; }
 
-void Buf_HermiteVector3::AppendToString(std::stringstream &buffer) const {
+char *Buf_HermiteVector3::AppendToString(char *out) const {
   ReflectorWrap<const Buf_HermiteVector3> tRefl(this);
+  const std::string flagsStr = tRefl.GetReflectedValue(0);
 
-  buffer << "{ " << tRefl.GetReflectedValue(2) << ", "
-         << tRefl.GetReflectedValue(1) << ", " << tRefl.GetReflectedValue(0);
+  out = WriteText(out, "{ ");
+  out = WriteVector(out, data);
+  out = WriteText(out, ", ");
+  out = WriteNumber(out, additiveFrames);
+  out = WriteText(out, ", ");
+  out = WriteText(out, flagsStr);
 
   size_t curTang = 0;
 
   for (size_t f = 0; f < 6; f++) {
     if (flags[static_cast<Buf_HermiteVector3_Flags>(f)]) {
-      buffer << ", " << tangents[curTang++];
+      out = WriteText(out, ", ");
+      out = WriteNumber(out, tangents[curTang++]);
     }
   }
 
-  buffer << " }";
+  return WriteText(out, " }");
 }
 
 std::string_view
 Buf_HermiteVector3::RetreiveFromString(std::string_view buffer) {
   buffer = SeekTo(buffer, '{');
-  buffer = es::SkipStartWhitespace(buffer, true);
-
-  ReflectorWrap<Buf_HermiteVector3> tRefl(this);
-  tRefl.SetReflectedValue(2, buffer);
-
-  buffer = SeekTo(buffer, ',');
-  buffer = es::SkipStartWhitespace(buffer, true);
-
-  tRefl.SetReflectedValue(1, buffer);
-
+  buffer = ReadVector(buffer, data);
+  buffer = ReadNumber(buffer, additiveFrames);
   buffer = SeekTo(buffer, ',');
-  buffer = es::SkipStartWhitespace(buffer, true);
 
-  tRefl.SetReflectedValue(0, buffer);
-
-  buffer = SeekTo(buffer, ',');
-  buffer = es::SkipStartWhitespace(buffer, true);
+  // Flags are the only named values, everything else is numeric
+  const size_t flagsEnd =
+      std::min(buffer.find_first_of(",}\n"), buffer.size());
+  std::string_view flagsStr = buffer.substr(0, flagsEnd);
+  buffer.remove_prefix(flagsEnd);
+  flagsStr = es::SkipStartWhitespace(flagsStr, true);
+  flagsStr = flagsStr.substr(0, flagsStr.find_last_not_of(" \t\r") + 1);
+  flags = {};
+
+  if (!flagsStr.empty()) {
+    ReflectorWrap<Buf_HermiteVector3> tRefl(this);
+    tRefl.SetReflectedValue(0, flagsStr);
+  }
 
   size_t curTang = 0;
 
   for (size_t f = 0; f < 6; f++) {
     if (flags[static_cast<Buf_HermiteVector3_Flags>(f)]) {
-      tangents[curTang++] = static_cast<float>(std::atof(buffer.data()));
-      buffer = SeekTo(buffer, ',');
-      buffer = es::SkipStartWhitespace(buffer, true);
+      buffer = ReadNumber(buffer, tangents[curTang++]);
     }
   }
 
@@ -389,8 +422,8 @@ void Buf_HermiteVector3::SwapEndian() {
 
 size_t Buf_SphericalRotation::Size() const { return 8; }
 
-void Buf_SphericalRotation::AppendToString(std::stringstream &buffer) const {
-  AppendToStringRaw(this, buffer);
+char *Buf_SphericalRotation::AppendToString(char *out) const {
+  return AppendToStringRaw(this, out);
 }
 
 std::string_view
@@ -504,9 +537,8 @@ void Buf_SphericalRotation::SwapEndian() { FByteswapper(data); }
 
 size_t Buf_BiLinearVector3_16bit::Size() const { return 8; }
 
-void Buf_BiLinearVector3_16bit::AppendToString(
-    std::stringstream &buffer) const {
-  AppendToStringRaw(this, buffer);
+char *Buf_BiLinearVector3_16bit::AppendToString(char *out) const {
+  return AppendToStringRaw(this, out);
 }
 
 std::string_view
@@ -561,8 +593,8 @@ const Vector4A16 Buf_BiLinearVector3_16bit::componentMultiplier =
 
 size_t Buf_BiLinearVector3_8bit::Size() const { return 4; }
 
-void Buf_BiLinearVector3_8bit::AppendToString(std::stringstream &buffer) const {
-  AppendToStringRaw(this, buffer);
+char *Buf_BiLinearVector3_8bit::AppendToString(char *out) const {
+  return AppendToStringRaw(this, out);
 }
 
 std::string_view
@@ -672,9 +704,8 @@ void Buf_LinearRotationQuat4_14bit::Interpolate(
 
 size_t Buf_BiLinearRotationQuat4_7bit::Size() const { return 4; }
 
-void Buf_BiLinearRotationQuat4_7bit::AppendToString(
-    std::stringstream &buffer) const {
-  AppendToStringRaw(this, buffer);
+char *Buf_BiLinearRotationQuat4_7bit::AppendToString(char *out) const {
+  return AppendToStringRaw(this, out);
 }
 
 std::string_view
@@ -799,9 +830,8 @@ void Buf_BiLinearRotationQuatZW_14bit::Interpolate(
 
 size_t Buf_BiLinearRotationQuat4_11bit::Size() const { return 6; }
 
-void Buf_BiLinearRotationQuat4_11bit::AppendToString(
-    std::stringstream &buffer) const {
-  AppendToStringRaw(this, buffer);
+char *Buf_BiLinearRotationQuat4_11bit::AppendToString(char *out) const {
+  return AppendToStringRaw(this, out);
 }
 
 std::string_view
@@ -852,9 +882,8 @@ void Buf_BiLinearRotationQuat4_11bit::SwapEndian() { FByteswapper(data); }
 
 size_t Buf_BiLinearRotationQuat4_9bit::Size() const { return 5; }
 
-void Buf_BiLinearRotationQuat4_9bit::AppendToString(
-    std::stringstream &buffer) const {
-  AppendToStringRaw(this, buffer);
+char *Buf_BiLinearRotationQuat4_9bit::AppendToString(char *out) const {
+  return AppendToStringRaw(this, out);
 }
 
 std::string_view
@@ -904,31 +933,42 @@ void Buf_BiLinearRotationQuat4_9bit::Interpolate(
 template <class C>
 void Buff_EvalShared<C>::ToString(std::string &strBuff,
                                   size_t numIdents) const {
-  std::stringstream str;
-  str << std::endl << idents[numIdents];
+  Decode();
+  const size_t numLines = data.size() / C::NEWLINEMOD + 2;
+  strBuff.resize(data.size() * C::TEXT_SIZE + numLines * (numIdents + 1));
+
+  char *out = strBuff.data();
+  auto NewLine = [&out](size_t numTabs) {
+    *out++ = '\n';
+    out = WriteText(out, {idents[numTabs], numTabs});
+  };
 
+  NewLine(numIdents);
   size_t curLine = 1;
 
   for (auto &d : data) {
-    d.AppendToString(str);
+    out = d.AppendToString(out);
 
     if (!(curLine % C::NEWLINEMOD)) {
-      str << std::endl << idents[numIdents];
+      NewLine(numIdents);
     }
 
     curLine++;
   }
 
   if (!((curLine - 1) % C::NEWLINEMOD)) {
-    str.seekp(-1, std::ios_base::cur) << '\0';
+    // Closing line is one level less indented
+    out--;
   } else {
-    str << std::endl << idents[numIdents - 1];
+    NewLine(numIdents - 1);
   }
 
-  strBuff = std::move(str).str();
+  strBuff.resize(out - strBuff.data());
 }
 
 template <class C> void Buff_EvalShared<C>::FromString(std::string_view input) {
+  Decode();
+
   for (auto &d : data) {
     input = d.RetreiveFromString(input);
   }
@@ -950,8 +990,15 @@ void Buff_EvalShared<C>::Assign(char *ptr, size_t size, bool swapEndian) {
     data = internalData;
   }
 
-  if (swapEndian) {
-    SwapEndian();
+  lazyDecode = true;
+  pendingSwap = swapEndian;
+}
+
+template <class C> void Buff_EvalShared<C>::DecodeOnce() const {
+  if (pendingSwap) {
+    for (auto &d : data) {
+      d.SwapEndian();
+    }
   }
 
   frames.resize(NumFrames());
@@ -964,7 +1011,37 @@ void Buff_EvalShared<C>::Assign(char *ptr, size_t size, bool swapEndian) {
   }
 }
 
+template <class C>
+void Buff_EvalShared<C>::Sample(std::span<Vector4A16> out,
+                                std::span<const float> times, float frameRate,
+                                int32 frameOffset, const TrackMinMax &bounds,
+                                const Vector4A16 &lastValue) const {
+  Decode();
+  const int32 maxFrame = frames.back();
+  LMTTrackCursor cursor;
+
+  for (size_t i = 0; i < times.size(); i++) {
+    float frameDelta = times[i] * frameRate;
+    const int32 frame = static_cast<int32>(frameDelta) + frameOffset;
+    frameDelta += frameOffset;
+
+    if (frame >= maxFrame) {
+      out[i] = lastValue;
+      continue;
+    }
+
+    const size_t f = FindKey(frames, frame, cursor);
+    const float boundFrame = static_cast<float>(frames[f]);
+    const float prevFrame = static_cast<float>(frames[f - 1]);
+    const float delta = (prevFrame - frameDelta) / (prevFrame - boundFrame);
+
+    data[f - 1].Interpolate(out[i], data[f], delta, bounds);
+  }
+}
+
 template <class C> void Buff_EvalShared<C>::Save(BinWritterRef wr) const {
+  Decode();
+
   if constexpr (!C::VARIABLE_SIZE) {
     if (!wr.SwappedEndian()) {
       wr.WriteBuffer(reinterpret_cast<const char *>(data.data()),
@@ -982,6 +1059,8 @@ template <class C> void Buff_EvalShared<C>::Save(BinWritterRef wr) const {
 }
 
 template <class C> void Buff_EvalShared<C>::SwapEndian() {
+  Decode();
+
   for (auto &d : data) {
     d.SwapEndian();
   }
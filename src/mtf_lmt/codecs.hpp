@@ -19,16 +19,27 @@
 #include "internal.hpp"
 #include "spike/reflect/reflector.hpp"
 #include "spike/type/flags.hpp"
+#include <mutex>
 #include <span>
 
 static constexpr float fPI = 3.14159265f;
 static constexpr float fPI2 = 0.5 * fPI;
 
+Vector4A16 slerp(const Vector4A16 &v0, const Vector4A16 &v1, float t);
+
+// Longest std::to_chars output of float or 32 bit integer
+static constexpr size_t TEXT_NUMBER_SIZE = 16;
+// Text vector: [x, y, z]
+static constexpr size_t TEXT_VECTOR_SIZE = TEXT_NUMBER_SIZE * 3 + 6;
+
 struct Buf_SingleVector3 {
   Vector data;
 
   static constexpr size_t NEWLINEMOD = 1;
+  static constexpr size_t TEXT_SIZE = TEXT_VECTOR_SIZE;
   static constexpr bool VARIABLE_SIZE = false;
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::Linear;
 
   size_t Size() const;
 
@@ -36,7 +47,8 @@ struct Buf_SingleVector3 {
 
   int32 GetFrame() const;
 
-  void AppendToString(std::stringstream &buffer) const;
+  // Returns end of written text, at most TEXT_SIZE characters
+  char *AppendToString(char *out) const;
 
   std::string_view RetreiveFromString(std::string_view buffer);
 
@@ -53,6 +65,9 @@ struct Buf_SingleVector3 {
 };
 
 struct Buf_StepRotationQuat3 : Buf_SingleVector3 {
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::Spherical;
+
   void Evaluate(Vector4A16 &out) const;
   void Interpolate(Vector4A16 &out, const Buf_StepRotationQuat3 &rightFrame,
                    float delta, const TrackMinMax &) const;
@@ -63,11 +78,14 @@ struct Buf_LinearVector3 {
   uint32 additiveFrames;
 
   static constexpr size_t NEWLINEMOD = 1;
+  static constexpr size_t TEXT_SIZE = TEXT_VECTOR_SIZE + TEXT_NUMBER_SIZE + 6;
   static constexpr bool VARIABLE_SIZE = false;
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::Linear;
 
   size_t Size() const;
 
-  void AppendToString(std::stringstream &buffer) const;
+  char *AppendToString(char *out) const;
 
   std::string_view RetreiveFromString(std::string_view buffer);
 
@@ -100,11 +118,15 @@ struct Buf_HermiteVector3 {
   float tangents[6];
 
   static constexpr size_t NEWLINEMOD = 1;
+  // Includes reflected flag names
+  static constexpr size_t TEXT_SIZE = 512;
   static constexpr bool VARIABLE_SIZE = true;
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::Hermite;
 
   size_t Size() const;
 
-  void AppendToString(std::stringstream &buffer) const;
+  char *AppendToString(char *out) const;
 
   std::string_view RetreiveFromString(std::string_view buffer);
 
@@ -132,12 +154,15 @@ struct Buf_SphericalRotation {
   uint64 data;
 
   static constexpr size_t NEWLINEMOD = 4;
+  static constexpr size_t TEXT_SIZE = 16;
   static constexpr bool VARIABLE_SIZE = false;
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::Spherical;
   static constexpr size_t MAXFRAMES = 255;
 
   size_t Size() const;
 
-  void AppendToString(std::stringstream &buffer) const;
+  char *AppendToString(char *out) const;
 
   std::string_view RetreiveFromString(std::string_view buffer);
 
@@ -172,11 +197,14 @@ struct Buf_BiLinearVector3_16bit {
   uint16 additiveFrames;
 
   static constexpr size_t NEWLINEMOD = 4;
+  static constexpr size_t TEXT_SIZE = 16;
   static constexpr bool VARIABLE_SIZE = false;
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::BoundedLinear;
 
   size_t Size() const;
 
-  void AppendToString(std::stringstream &buffer) const;
+  char *AppendToString(char *out) const;
 
   std::string_view RetreiveFromString(std::string_view buffer);
 
@@ -205,11 +233,14 @@ struct Buf_BiLinearVector3_8bit {
   uint8 additiveFrames;
 
   static constexpr size_t NEWLINEMOD = 7;
+  static constexpr size_t TEXT_SIZE = 8;
   static constexpr bool VARIABLE_SIZE = false;
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::BoundedLinear;
 
   size_t Size() const;
 
-  void AppendToString(std::stringstream &buffer) const;
+  char *AppendToString(char *out) const;
 
   std::string_view RetreiveFromString(std::string_view buffer);
 
@@ -254,11 +285,14 @@ struct Buf_BiLinearRotationQuat4_7bit {
   uint32 data;
 
   static constexpr size_t NEWLINEMOD = 8;
+  static constexpr size_t TEXT_SIZE = 8;
   static constexpr bool VARIABLE_SIZE = false;
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::BoundedSpherical;
 
   size_t Size() const;
 
-  void AppendToString(std::stringstream &buffer) const;
+  char *AppendToString(char *out) const;
 
   std::string_view RetreiveFromString(std::string_view buffer);
 
@@ -325,11 +359,14 @@ struct Buf_BiLinearRotationQuat4_11bit {
   USVector data;
 
   static constexpr size_t NEWLINEMOD = 6;
+  static constexpr size_t TEXT_SIZE = 12;
   static constexpr bool VARIABLE_SIZE = false;
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::BoundedSpherical;
 
   size_t Size() const;
 
-  void AppendToString(std::stringstream &buffer) const;
+  char *AppendToString(char *out) const;
 
   std::string_view RetreiveFromString(std::string_view buffer);
 
@@ -355,11 +392,14 @@ struct Buf_BiLinearRotationQuat4_9bit {
   uint8 data[5];
 
   static constexpr size_t NEWLINEMOD = 6;
+  static constexpr size_t TEXT_SIZE = 10;
   static constexpr bool VARIABLE_SIZE = false;
+  static constexpr LMTKeyInterpolation INTERPOLATION =
+      LMTKeyInterpolation::BoundedSpherical;
 
   size_t Size() const;
 
-  void AppendToString(std::stringstream &buffer) const;
+  char *AppendToString(char *out) const;
 
   std::string_view RetreiveFromString(std::string_view buffer);
 
@@ -381,39 +421,102 @@ struct Buf_BiLinearRotationQuat4_9bit {
   void SwapEndian() {}
 };
 
+// Reference bulk decoder, evaluates keys one by one
+template <class C>
+void DecodeKeysScalar(std::span<const C> keys, LMTKeysSoA out) {
+  for (size_t i = 0; i < keys.size(); i++) {
+    Vector4A16 value;
+    keys[i].Evaluate(value);
+    out.x[i] = value.X;
+    out.y[i] = value.Y;
+    out.z[i] = value.Z;
+    out.w[i] = value.W;
+  }
+}
+
+template <class C> void DecodeKeys(std::span<const C> keys, LMTKeysSoA out) {
+  DecodeKeysScalar(keys, out);
+}
+
+// Vectorized decoders (AVX2 or SSE2), results are bit exact with Evaluate
+void DecodeKeys(std::span<const Buf_LinearRotationQuat4_14bit> keys,
+                LMTKeysSoA out);
+void DecodeKeys(std::span<const Buf_BiLinearRotationQuat4_7bit> keys,
+                LMTKeysSoA out);
+void DecodeKeys(std::span<const Buf_BiLinearRotationQuat4_11bit> keys,
+                LMTKeysSoA out);
+void DecodeKeys(std::span<const Buf_BiLinearRotationQuat4_9bit> keys,
+                LMTKeysSoA out);
+
 template <class C> struct Buff_EvalShared : LMTTrackController {
   std::span<C> data;
   std::vector<C> internalData;
-  std::vector<int16> frames;
+  mutable std::vector<int16> frames;
+  // Assigned keys are byteswapped and frames are built on first key access
+  // so untouched tracks of mapped files are never paged in
+  mutable std::once_flag decodeFlag;
+  bool lazyDecode = false;
+  bool pendingSwap = false;
+
+  void Decode() const {
+    if (lazyDecode) {
+      std::call_once(decodeFlag, [this] { DecodeOnce(); });
+    }
+  }
 
-  int32 GetFrame(size_t frame) const override { return frames[frame]; }
+  void DecodeOnce() const;
+
+  int32 GetFrame(size_t frame) const override {
+    Decode();
+    return frames[frame];
+  }
+  std::span<const int16> Frames() const override {
+    Decode();
+    return frames;
+  }
   size_t NumFrames() const override { return data.size(); }
   void NumFrames(size_t numItems) override {
     internalData.resize(numItems);
     data = internalData;
   }
   bool IsCubic() const override { return C::VARIABLE_SIZE; }
+  LMTKeyInterpolation KeyInterpolation() const override {
+    return C::INTERPOLATION;
+  }
 
   void GetTangents(Vector4A16 &inTangs, Vector4A16 &outTangs,
                    size_t frame) const override {
     if constexpr (C::VARIABLE_SIZE) {
+      Decode();
       data[frame].GetTangents(inTangs, outTangs);
     }
   }
 
   void Evaluate(Vector4A16 &out, size_t frame) const override {
+    Decode();
     data[frame].Evaluate(out);
   }
 
   void Interpolate(Vector4A16 &out, size_t frame, float delta,
                    const TrackMinMax &bounds) const override {
+    Decode();
     data[frame].Interpolate(out, data[frame + 1], delta, bounds);
   }
 
   void Devaluate(const Vector4A16 &in, size_t frame) override {
+    Decode();
     data[frame].Devaluate(in);
   }
 
+  void Sample(std::span<Vector4A16> out, std::span<const float> times,
+              float frameRate, int32 frameOffset, const TrackMinMax &bounds,
+              const Vector4A16 &lastValue) const override;
+
+  void DecodeKeys(LMTKeysSoA out) const override {
+    Decode();
+    ::DecodeKeys(std::span<const C>(data), out);
+  }
+
   void ToString(std::string &strBuff, size_t numIdents) const override;
 
   void FromString(std::string_view input) override;
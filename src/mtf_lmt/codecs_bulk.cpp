@@ -0,0 +1,258 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "codecs.hpp"
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LMT_BULK_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LMT_BULK_SSE2
+#endif
+
+/*
+Bulk decoders work on LANES keys at once, remaining keys go through
+DecodeKeysScalar.
+Components are extracted in integer domain and converted to float with the
+same single multiplication as Evaluate, so results are bit exact.
+64 bit keys are split into low and high 32 bit halves, components crossing
+the halves are merged.
+*/
+
+namespace {
+#if defined(LMT_BULK_AVX2)
+using VecI = __m256i;
+static constexpr size_t LANES = 8;
+
+// Low and high 32 bits of LANES 64 bit keys
+struct Keys64 {
+  VecI lo;
+  VecI hi;
+};
+
+VecI Load32(const uint32 *keys) {
+  return _mm256_loadu_si256(reinterpret_cast<const VecI *>(keys));
+}
+
+Keys64 Split64(VecI a, VecI b) {
+  const __m256 af = _mm256_castsi256_ps(a);
+  const __m256 bf = _mm256_castsi256_ps(b);
+  // Shuffle works per 128 bit lane: k0 k1 k4 k5 | k2 k3 k6 k7
+  const VecI lo =
+      _mm256_castps_si256(_mm256_shuffle_ps(af, bf, _MM_SHUFFLE(2, 0, 2, 0)));
+  const VecI hi =
+      _mm256_castps_si256(_mm256_shuffle_ps(af, bf, _MM_SHUFFLE(3, 1, 3, 1)));
+  return {_mm256_permute4x64_epi64(lo, _MM_SHUFFLE(3, 1, 2, 0)),
+          _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(3, 1, 2, 0))};
+}
+
+Keys64 Load64(const uint64 *keys) {
+  return Split64(_mm256_loadu_si256(reinterpret_cast<const VecI *>(keys)),
+                 _mm256_loadu_si256(reinterpret_cast<const VecI *>(keys + 4)));
+}
+
+Keys64 Make64(const uint64 *keys) {
+  return Split64(_mm256_set_epi64x(keys[3], keys[2], keys[1], keys[0]),
+                 _mm256_set_epi64x(keys[7], keys[6], keys[5], keys[4]));
+}
+
+VecI Set(int32 value) { return _mm256_set1_epi32(value); }
+VecI And(VecI a, VecI b) { return _mm256_and_si256(a, b); }
+VecI Or(VecI a, VecI b) { return _mm256_or_si256(a, b); }
+VecI Sub(VecI a, VecI b) { return _mm256_sub_epi32(a, b); }
+VecI Greater(VecI a, VecI b) { return _mm256_cmpgt_epi32(a, b); }
+template <int N> VecI Shl(VecI a) { return _mm256_slli_epi32(a, N); }
+template <int N> VecI Shr(VecI a) { return _mm256_srli_epi32(a, N); }
+
+void Store(float *out, VecI value, float multiplier) {
+  _mm256_storeu_ps(out, _mm256_mul_ps(_mm256_cvtepi32_ps(value),
+                                      _mm256_set1_ps(multiplier)));
+}
+#elif defined(LMT_BULK_SSE2)
+using VecI = __m128i;
+static constexpr size_t LANES = 4;
+
+// Low and high 32 bits of LANES 64 bit keys
+struct Keys64 {
+  VecI lo;
+  VecI hi;
+};
+
+VecI Load32(const uint32 *keys) {
+  return _mm_loadu_si128(reinterpret_cast<const VecI *>(keys));
+}
+
+Keys64 Split64(VecI a, VecI b) {
+  const __m128 af = _mm_castsi128_ps(a);
+  const __m128 bf = _mm_castsi128_ps(b);
+  return {_mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(2, 0, 2, 0))),
+          _mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(3, 1, 3, 1)))};
+}
+
+Keys64 Load64(const uint64 *keys) {
+  return Split64(_mm_loadu_si128(reinterpret_cast<const VecI *>(keys)),
+                 _mm_loadu_si128(reinterpret_cast<const VecI *>(keys + 2)));
+}
+
+Keys64 Make64(const uint64 *keys) {
+  return Split64(_mm_set_epi64x(keys[1], keys[0]),
+                 _mm_set_epi64x(keys[3], keys[2]));
+}
+
+VecI Set(int32 value) { return _mm_set1_epi32(value); }
+VecI And(VecI a, VecI b) { return _mm_and_si128(a, b); }
+VecI Or(VecI a, VecI b) { return _mm_or_si128(a, b); }
+VecI Sub(VecI a, VecI b) { return _mm_sub_epi32(a, b); }
+VecI Greater(VecI a, VecI b) { return _mm_cmpgt_epi32(a, b); }
+template <int N> VecI Shl(VecI a) { return _mm_slli_epi32(a, N); }
+template <int N> VecI Shr(VecI a) { return _mm_srli_epi32(a, N); }
+
+void Store(float *out, VecI value, float multiplier) {
+  _mm_storeu_ps(out,
+                _mm_mul_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(multiplier)));
+}
+#endif
+
+#if defined(LMT_BULK_AVX2) || defined(LMT_BULK_SSE2)
+#define LMT_BULK_SIMD
+
+// Reads 8 bytes of every packed key smaller than 8 bytes
+// Reads past the last key, caller must keep at least one key after the run
+template <class C> Keys64 Gather64(const C *keys) {
+  static_assert(sizeof(C) < sizeof(uint64));
+  uint64 wide[LANES];
+
+  for (size_t l = 0; l < LANES; l++) {
+    memcpy(wide + l, keys + l, sizeof(uint64));
+  }
+
+  return Make64(wide);
+}
+#endif
+
+LMTKeysSoA Advance(LMTKeysSoA out, size_t numKeys) {
+  return {out.x + numKeys, out.y + numKeys, out.z + numKeys, out.w + numKeys};
+}
+} // namespace
+
+void DecodeKeys(std::span<const Buf_LinearRotationQuat4_14bit> keys,
+                LMTKeysSoA out) {
+  using C = Buf_LinearRotationQuat4_14bit;
+  size_t i = 0;
+
+#ifdef LMT_BULK_SIMD
+  static_assert(sizeof(C) == sizeof(uint64));
+  const VecI mask = Set(C::componentMask);
+  // Values above half of range are negative: value - componentMask
+  const VecI signMax = Set(C::componentMask / 2);
+  auto Signed = [&](VecI value) {
+    return Sub(value, And(Greater(value, signMax), mask));
+  };
+
+  for (; i + LANES <= keys.size(); i += LANES) {
+    const Keys64 k = Load64(&keys[i].data);
+    const VecI x = And(Shr<10>(k.hi), mask);
+    const VecI y = Or(Shr<28>(k.lo), Shl<4>(And(k.hi, Set(0x3ff))));
+    const VecI z = And(Shr<14>(k.lo), mask);
+    const VecI w = And(k.lo, mask);
+
+    Store(out.x + i, Signed(x), C::componentMultiplier);
+    Store(out.y + i, Signed(y), C::componentMultiplier);
+    Store(out.z + i, Signed(z), C::componentMultiplier);
+    Store(out.w + i, Signed(w), C::componentMultiplier);
+  }
+#endif
+
+  DecodeKeysScalar(keys.subspan(i), Advance(out, i));
+}
+
+void DecodeKeys(std::span<const Buf_BiLinearRotationQuat4_7bit> keys,
+                LMTKeysSoA out) {
+  using C = Buf_BiLinearRotationQuat4_7bit;
+  size_t i = 0;
+
+#ifdef LMT_BULK_SIMD
+  static_assert(sizeof(C) == sizeof(uint32));
+  const VecI mask = Set(C::componentMask);
+
+  for (; i + LANES <= keys.size(); i += LANES) {
+    const VecI k = Load32(&keys[i].data);
+    Store(out.x + i, And(Shr<21>(k), mask), C::componentMultiplier);
+    Store(out.y + i, And(Shr<14>(k), mask), C::componentMultiplier);
+    Store(out.z + i, And(Shr<7>(k), mask), C::componentMultiplier);
+    Store(out.w + i, And(k, mask), C::componentMultiplier);
+  }
+#endif
+
+  DecodeKeysScalar(keys.subspan(i), Advance(out, i));
+}
+
+void DecodeKeys(std::span<const Buf_BiLinearRotationQuat4_11bit> keys,
+                LMTKeysSoA out) {
+  using C = Buf_BiLinearRotationQuat4_11bit;
+  size_t i = 0;
+
+#ifdef LMT_BULK_SIMD
+  const VecI mask = Set(C::componentMask);
+
+  // Low bits of Y and Z are stored after their high bits
+  for (; i + LANES < keys.size(); i += LANES) {
+    const Keys64 k = Gather64(&keys[i]);
+    const VecI x = And(k.lo, mask);
+    const VecI y = Or(Shl<6>(And(Shr<11>(k.lo), Set(0x1f))),
+                      And(Shr<16>(k.lo), Set(0x3f)));
+    const VecI z = Or(Shl<1>(Shr<22>(k.lo)), And(k.hi, Set(1)));
+    const VecI w = And(Shr<1>(k.hi), mask);
+
+    Store(out.x + i, x, C::componentMultiplier);
+    Store(out.y + i, y, C::componentMultiplier);
+    Store(out.z + i, z, C::componentMultiplier);
+    Store(out.w + i, w, C::componentMultiplier);
+  }
+#endif
+
+  DecodeKeysScalar(keys.subspan(i), Advance(out, i));
+}
+
+void DecodeKeys(std::span<const Buf_BiLinearRotationQuat4_9bit> keys,
+                LMTKeysSoA out) {
+  using C = Buf_BiLinearRotationQuat4_9bit;
+  size_t i = 0;
+
+#ifdef LMT_BULK_SIMD
+  // Low bits of every component are stored after their high bits
+  for (; i + LANES < keys.size(); i += LANES) {
+    const Keys64 k = Gather64(&keys[i]);
+    const VecI x =
+        Or(Shl<1>(And(k.lo, Set(0xff))), And(Shr<8>(k.lo), Set(1)));
+    const VecI y =
+        Or(Shl<2>(And(Shr<9>(k.lo), Set(0x7f))), And(Shr<16>(k.lo), Set(3)));
+    const VecI z =
+        Or(Shl<3>(And(Shr<18>(k.lo), Set(0x3f))), And(Shr<24>(k.lo), Set(7)));
+    const VecI w = Or(Shl<4>(Shr<27>(k.lo)), And(k.hi, Set(0xf)));
+
+    Store(out.x + i, x, C::componentMultiplier);
+    Store(out.y + i, y, C::componentMultiplier);
+    Store(out.z + i, z, C::componentMultiplier);
+    Store(out.w + i, w, C::componentMultiplier);
+  }
+#endif
+
+  DecodeKeysScalar(keys.subspan(i), Advance(out, i));
+}
@@ -64,7 +64,7 @@ void FByteswapper(AnimEventsHeaderV2 &item) {
 
 template <>
 void ProcessClass(AnimEventV2 &item, LMTConstructorProperties flags) {
-  if (item.frames.Check(flags.ptrStore)) {
+  if (!flags.fixups.Insert(&item.frames)) {
     return;
   }
 
@@ -72,7 +72,7 @@ void ProcessClass(AnimEventV2 &item, LMTConstructorProperties flags) {
     FByteswapper(item);
   }
 
-  item.frames.Fixup(flags.base, flags.ptrStore);
+  flags.fixups.Fixup(item.frames, flags.base);
 
   AnimEventFrameV2 *frames_ = item.frames;
 
@@ -83,7 +83,7 @@ void ProcessClass(AnimEventV2 &item, LMTConstructorProperties flags) {
 
 template <>
 void ProcessClass(AnimEventGroupV2 &item, LMTConstructorProperties flags) {
-  if (item.events.Check(flags.ptrStore)) {
+  if (!flags.fixups.Insert(&item.events)) {
     return;
   }
 
@@ -91,7 +91,7 @@ void ProcessClass(AnimEventGroupV2 &item, LMTConstructorProperties flags) {
     FByteswapper(item);
   }
 
-  item.events.Fixup(flags.base, flags.ptrStore);
+  flags.fixups.Fixup(item.events, flags.base);
 
   AnimEventV2 *events_ = item.events;
 
@@ -102,7 +102,7 @@ void ProcessClass(AnimEventGroupV2 &item, LMTConstructorProperties flags) {
 
 template <>
 void ProcessClass(AnimEventsHeaderV2 &item, LMTConstructorProperties flags) {
-  if (item.eventGroups.Check(flags.ptrStore)) {
+  if (!flags.fixups.Insert(&item.eventGroups)) {
     return;
   }
 
@@ -110,7 +110,7 @@ void ProcessClass(AnimEventsHeaderV2 &item, LMTConstructorProperties flags) {
     FByteswapper(item);
   }
 
-  item.eventGroups.Fixup(flags.base, flags.ptrStore);
+  flags.fixups.Fixup(item.eventGroups, flags.base);
 
   AnimEventGroupV2 *groups = item.eventGroups;
 
@@ -219,7 +219,7 @@ void ProcessClass(LMTAnimationEventMidInterface &item,
   if (item.interface.LayoutVersion() >= LMT92) {
     auto ptr = item.interface.GroupsPtr();
 
-    if (ptr.Check(flags.ptrStore)) {
+    if (!flags.fixups.Insert(ptr.data)) {
       return;
     }
 
@@ -227,7 +227,7 @@ void ProcessClass(LMTAnimationEventMidInterface &item,
       clgen::EndianSwap(item.interface);
     }
 
-    ptr.Fixup(flags.base, flags.ptrStore);
+    flags.fixups.Fixup(ptr, flags.base);
     ProcessClass(**ptr, flags);
     item.v2.emplace(*ptr);
     return;
@@ -240,7 +240,7 @@ void ProcessClass(LMTAnimationEventMidInterface &item,
   }
 
   for (size_t gindex = 0; auto g : groupSpan) {
-    if (g.EventsPtr().Check(flags.ptrStore)) {
+    if (!flags.fixups.Insert(g.EventsPtr().data)) {
       return;
     }
 
@@ -248,7 +248,7 @@ void ProcessClass(LMTAnimationEventMidInterface &item,
       clgen::EndianSwap(g);
     }
 
-    g.EventsPtr().Fixup(flags.base, flags.ptrStore);
+    flags.fixups.Fixup(g.EventsPtr(), flags.base);
 
     if (flags.swapEndian) {
       for (auto &a : item.GetFrames(gindex++)) {
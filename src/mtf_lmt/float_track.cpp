@@ -39,9 +39,9 @@ public:
   } {
   }
 
-  void Fixup(char *root, bool swapEndian, std::vector<void *> &ptrStore) {
+  void Fixup(char *root, bool swapEndian, FixupRegistry &fixups) {
     for (auto g : interface.Groups()) {
-      if (g.FramesPtr().Check(ptrStore)) {
+      if (!fixups.Insert(g.FramesPtr().data)) {
         return;
       }
 
@@ -49,7 +49,7 @@ public:
         clgen::EndianSwap(interface);
       }
 
-      g.FramesPtr().Fixup(root, ptrStore);
+      fixups.Fixup(g.FramesPtr(), root);
 
       if (swapEndian) {
         auto frames = g.Frames();
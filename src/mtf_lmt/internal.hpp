@@ -16,6 +16,8 @@
 */
 
 #pragma once
+#include "../fixup_registry.hpp"
+#include "../mapped_file.hpp"
 #include "revil/lmt.hpp"
 #include "spike/type/pointer.hpp"
 #include "spike/type/vectors_simd.hpp"
@@ -23,6 +25,8 @@
 #include "spike/uni/list_vector.hpp"
 #include "spike/util/endian.hpp"
 #include <memory>
+#include <mutex>
+#include <span>
 #include <vector>
 
 using namespace revil;
@@ -61,16 +65,51 @@ enum class TrackTypesShared {
   BiLinearRotationQuat4_9bit
 };
 
+// Interpolation between two evaluated keys
+// Bounded keys are transformed by track extremes before interpolation
+enum class LMTKeyInterpolation : uint8 {
+  Linear,
+  Spherical,
+  BoundedLinear,
+  BoundedSpherical,
+  Hermite,
+};
+
+// Structure of arrays output of bulk key decoders
+struct LMTKeysSoA {
+  float *x;
+  float *y;
+  float *z;
+  float *w;
+};
+
+// Returns first key past frame, frame must be below the last key
+// Ascending frames are resolved by stepping from cursor, binary search
+// is used for seeks
+size_t FindKey(std::span<const int16> frames, int32 frame,
+               LMTTrackCursor &cursor);
+
 struct LMTTrackController {
   virtual size_t NumFrames() const = 0;
   virtual bool IsCubic() const = 0;
+  virtual LMTKeyInterpolation KeyInterpolation() const = 0;
   virtual void GetTangents(Vector4A16 &inTangs, Vector4A16 &outTangs,
                            size_t frame) const = 0;
   virtual void Evaluate(Vector4A16 &out, size_t frame) const = 0;
   virtual void Interpolate(Vector4A16 &out, size_t frame, float delta,
                            const TrackMinMax &bounds) const = 0;
   virtual int32 GetFrame(size_t frameID) const = 0;
+  // Absolute frame of every key
+  virtual std::span<const int16> Frames() const = 0;
   virtual void NumFrames(size_t numItems) = 0;
+  // Interpolates keys at times * frameRate + frameOffset
+  // Samples at or past the last key are set to lastValue
+  virtual void Sample(std::span<Vector4A16> out, std::span<const float> times,
+                      float frameRate, int32 frameOffset,
+                      const TrackMinMax &bounds,
+                      const Vector4A16 &lastValue) const = 0;
+  // Evaluates every key, out components must hold NumFrames() values
+  virtual void DecodeKeys(LMTKeysSoA out) const = 0;
   virtual void ToString(std::string &strBuf, size_t numIdents) const = 0;
 
   virtual void FromString(std::string_view input) = 0;
@@ -91,11 +130,11 @@ struct LMTConstructorProperties : LMTConstructorPropertiesBase {
   bool swapEndian = false; // optional, assign only
   void *dataStart = nullptr;
   char *base = nullptr;
-  std::vector<void *> &ptrStore;
+  FixupRegistry &fixups;
 
   LMTConstructorProperties(const LMTConstructorPropertiesBase &base,
-                           std::vector<void *> &store)
-      : ptrStore(store) {
+                           FixupRegistry &fixups_)
+      : fixups(fixups_) {
     operator=(base);
   }
 
@@ -107,8 +146,35 @@ struct LMTConstructorProperties : LMTConstructorPropertiesBase {
 class LMTImpl
     : public uni::PolyVectorList<uni::Motion, LMTAnimation, uni::Element> {
 public:
+  using base_type =
+      uni::PolyVectorList<uni::Motion, LMTAnimation, uni::Element>;
+
   std::string masterBuffer;
+  // Copy on write, only pages touched by fixups are copied
+  MappedFile mappedFile;
   LMTConstructorPropertiesBase props;
+
+  // Loaded animations, storage slots are filled on first access
+  char *buffer = nullptr;
+  bool swapEndian = false;
+  std::vector<uint32> offsets;
+  std::unique_ptr<std::once_flag[]> constructFlags;
+  std::vector<bool> constructed;
+  // Fixups write into shared buffer, construction is serialized
+  FixupRegistry fixups;
+  std::mutex constructMutex;
+
+  void InitBlocks(char *buffer_, std::vector<uint32> offsets_,
+                  bool swapEndian_);
+  LMTAnimation *Animation(size_t index);
+  void ConstructAll();
+  LMTBlockInfo BlockInfo(size_t index);
+
+  uni::Element<const uni::Motion> At(size_t index) const override {
+    // Construction does not change observable state
+    const_cast<LMTImpl *>(this)->Animation(index);
+    return base_type::At(index);
+  }
 };
 } // namespace revil
 
@@ -15,7 +15,7 @@
     along with this program.If not, see <https://www.gnu.org/licenses/>.
 */
 
-#include "internal.hpp"
+#include "animation.hpp"
 #include "spike/reflect/reflector.hpp"
 
 REFLECT(CLASS(TrackMinMax), MEMBER(min), MEMBER(max));
@@ -27,17 +27,91 @@ LMT::~LMT() = default;
 LMTVersion LMT::Version() const { return pi->props.version; }
 LMTArchType LMT::Architecture() const { return pi->props.arch; }
 auto LMT::CreateAnimation() const {
-  std::vector<void *> ptrStore;
-  LMTConstructorProperties cProps(pi->props, ptrStore);
+  FixupRegistry fixups;
+  LMTConstructorProperties cProps(pi->props, fixups);
   return LMTAnimation::Create(cProps);
 }
 
+void LMTImpl::InitBlocks(char *buffer_, std::vector<uint32> offsets_,
+                         bool swapEndian_) {
+  buffer = buffer_;
+  swapEndian = swapEndian_;
+  offsets = std::move(offsets_);
+  constructFlags = std::make_unique<std::once_flag[]>(offsets.size());
+  constructed.assign(offsets.size(), false);
+  storage.resize(offsets.size());
+}
+
+LMTAnimation *LMTImpl::Animation(size_t index) {
+  if (index < offsets.size()) {
+    std::call_once(constructFlags[index], [&] {
+      std::lock_guard<std::mutex> lg(constructMutex);
+
+      if (offsets[index]) {
+        LMTConstructorProperties cProps(props, fixups);
+        cProps.base = buffer;
+        cProps.swapEndian = swapEndian;
+        cProps.dataStart = buffer + offsets[index];
+        storage[index] = uni::ToElement(LMTAnimation::Create(cProps));
+      }
+
+      constructed[index] = true;
+    });
+  }
+
+  return storage.at(index).get();
+}
+
+void LMTImpl::ConstructAll() {
+  for (size_t a = 0; a < offsets.size(); a++) {
+    Animation(a);
+  }
+}
+
+LMTBlockInfo LMTImpl::BlockInfo(size_t index) {
+  std::lock_guard<std::mutex> lg(constructMutex);
+  LMTBlockInfo retVal;
+
+  if (index < offsets.size()) {
+    if (!offsets[index]) {
+      return retVal;
+    }
+
+    // Constructed headers are already swapped
+    if (!constructed[index]) {
+      retVal = ReadBlockInfo(buffer + offsets[index], props, swapEndian);
+      retVal.offset = offsets[index];
+      return retVal;
+    }
+
+    retVal.offset = offsets[index];
+  }
+
+  if (const LMTAnimation *anim = storage.at(index).get(); anim) {
+    retVal.numTracks = anim->Tracks()->Size();
+    retVal.numFrames = anim->NumFrames();
+    retVal.loopFrame = anim->LoopFrame();
+  }
+
+  return retVal;
+}
+
+size_t LMT::NumBlocks() const { return pi->storage.size(); }
+
+LMTBlockInfo LMT::BlockInfo(size_t index) const {
+  return pi->BlockInfo(index);
+}
+
+const LMTAnimation *LMT::Animation(size_t index) const {
+  return pi->Animation(index);
+}
+
 LMT::operator uni::MotionsConst() const {
   return uni::MotionsConst{pi.get(), false};
 }
 
 void LMT::Version(LMTVersion _version, LMTArchType _arch) {
-  if (!pi->masterBuffer.empty()) {
+  if (!pi->masterBuffer.empty() || !pi->mappedFile.Data().empty()) {
     throw std::runtime_error("Cannot set version for read only class!");
   }
 
@@ -67,6 +141,11 @@ void LMT::InsertAnimation(LMTAnimation *ani, size_t at, bool replace) {
     throw std::runtime_error("Cannot append animation. Properties mismatch.");
   }
 
+  // Replaced slot must not be constructed later
+  if (at < pi->offsets.size()) {
+    pi->Animation(at);
+  }
+
   if (at >= pi->storage.size()) {
     pi->storage.resize(at);
     pi->storage.emplace_back(ani);
@@ -0,0 +1,275 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "bone_track.hpp"
+#include "codecs.hpp"
+#include <algorithm>
+#include <map>
+
+struct PoseTrack {
+  LMTKeyInterpolation interpolation;
+  LMTTrack::TrackType_e trackType;
+  bool useRefFrame;
+  bool refStart; // first frame is blended from reference data
+  uint32 bone;
+  uint32 firstKey;
+  uint32 numKeys;
+  uint32 firstTangent;
+  Vector4A16 refData;
+  Vector4A16 firstValue;
+  Vector4A16 lastValue;
+};
+
+class revil::LMTPoseEvaluatorImpl {
+public:
+  std::vector<LMTPoseBone> bones;
+  std::vector<PoseTrack> tracks;
+  std::vector<int16> frames;
+  std::vector<float> keysX;
+  std::vector<float> keysY;
+  std::vector<float> keysZ;
+  std::vector<float> keysW;
+  std::vector<Vector4A16> tangents; // pairs of out and in tangent per key
+  float frameRate;
+  float duration;
+
+  LMTPoseEvaluatorImpl(const LMTAnimation &animation, float frameRate_);
+
+  Vector4A16 Key(size_t index) const {
+    return {keysX[index], keysY[index], keysZ[index], keysW[index]};
+  }
+
+  void Init(LMTPose &pose) const;
+  void Evaluate(const PoseTrack &track, LMTPose &pose, float time,
+                LMTTrackCursor &cursor) const;
+
+private:
+  void Compile(const LMTTrackInterface &track, uint32 bone);
+};
+
+LMTPoseEvaluatorImpl::LMTPoseEvaluatorImpl(const LMTAnimation &animation,
+                                           float frameRate_)
+    : frameRate(frameRate_),
+      duration(static_cast<float>(animation.NumFrames()) / frameRate_) {
+  std::map<uint32, std::vector<const LMTTrackInterface *>> boneTracks;
+
+  for (auto t : *animation.Tracks()) {
+    auto track = static_cast<const LMTTrackInterface *>(t.get());
+    boneTracks[track->BoneIndex()].push_back(track);
+  }
+
+  for (auto &[boneIndex, items] : boneTracks) {
+    LMTPoseBone bone{};
+    bone.index = boneIndex;
+    bone.boneType = items.front()->BoneType();
+
+    for (auto t : items) {
+      bone.trackTypes |= 1 << t->GetTrackType();
+      Compile(*t, bones.size());
+    }
+
+    bones.push_back(bone);
+  }
+}
+
+void LMTPoseEvaluatorImpl::Compile(const LMTTrackInterface &track,
+                                   uint32 bone) {
+  const LMTTrackController &controller = *track.controller;
+  const size_t numKeys = controller.NumFrames();
+  PoseTrack &pTrack = tracks.emplace_back();
+  pTrack.interpolation = controller.KeyInterpolation();
+  pTrack.trackType = track.GetTrackType();
+  pTrack.useRefFrame = track.useRefFrame;
+  pTrack.refStart = track.useRefFrame && track.loopFrame < 1;
+  pTrack.bone = bone;
+  pTrack.firstKey = frames.size();
+  pTrack.numKeys = numKeys;
+  pTrack.firstTangent = tangents.size();
+
+  if (track.useRefFrame) {
+    pTrack.refData = track.GetRefData();
+  }
+
+  if (!numKeys) {
+    return;
+  }
+
+  track.Evaluate(pTrack.firstValue, 0);
+  track.Evaluate(pTrack.lastValue, numKeys - 1);
+
+  auto ctrFrames = controller.Frames();
+  frames.insert(frames.end(), ctrFrames.begin(), ctrFrames.end());
+
+  for (auto pool : {&keysX, &keysY, &keysZ, &keysW}) {
+    pool->resize(frames.size());
+  }
+
+  const size_t k = pTrack.firstKey;
+  controller.DecodeKeys({keysX.data() + k, keysY.data() + k, keysZ.data() + k,
+                         keysW.data() + k});
+
+  if (pTrack.interpolation == LMTKeyInterpolation::BoundedLinear ||
+      pTrack.interpolation == LMTKeyInterpolation::BoundedSpherical) {
+    for (size_t i = k; i < frames.size(); i++) {
+      const Vector4A16 value = track.minMax.max + track.minMax.min * Key(i);
+      keysX[i] = value.X;
+      keysY[i] = value.Y;
+      keysZ[i] = value.Z;
+      keysW[i] = value.W;
+    }
+  } else if (pTrack.interpolation == LMTKeyInterpolation::Hermite) {
+    for (size_t i = 0; i < numKeys; i++) {
+      Vector4A16 outTangent, inTangent;
+      controller.GetTangents(outTangent, inTangent, i);
+      tangents.push_back(outTangent);
+      tangents.push_back(inTangent);
+    }
+  }
+}
+
+void LMTPoseEvaluatorImpl::Init(LMTPose &pose) const {
+  pose.rotations.assign(bones.size(), Vector4A16(0, 0, 0, 1));
+  pose.translations.assign(bones.size(), Vector4A16(0, 0, 0, 1));
+  pose.scales.assign(bones.size(), Vector4A16(1, 1, 1, 1));
+}
+
+// Mirrors LMTTrackInterface::GetValue and LMTTrackController::Interpolate
+void LMTPoseEvaluatorImpl::Evaluate(const PoseTrack &track, LMTPose &pose,
+                                    float time,
+                                    LMTTrackCursor &cursor) const {
+  Vector4A16 *out = nullptr;
+
+  switch (track.trackType) {
+  case LMTTrack::TrackType_LocalRotation:
+  case LMTTrack::TrackType_AbsoluteRotation:
+    out = &pose.rotations[track.bone];
+    break;
+  case LMTTrack::TrackType_LocalPosition:
+  case LMTTrack::TrackType_AbsolutePosition:
+    out = &pose.translations[track.bone];
+    break;
+  default:
+    out = &pose.scales[track.bone];
+    break;
+  }
+
+  if (!track.numKeys) {
+    if (track.useRefFrame) {
+      *out = track.refData;
+    }
+
+    return;
+  }
+
+  float frameDelta = time * frameRate;
+  int32 frame = static_cast<int32>(frameDelta);
+
+  if (track.refStart) {
+    if (!frame) {
+      if (frameDelta < 0.0001f) {
+        *out = track.refData;
+      } else {
+        *out = track.refData + (track.firstValue - track.refData) * frameDelta;
+      }
+
+      return;
+    }
+
+    frame--;
+    frameDelta -= 1.f;
+  }
+
+  const std::span<const int16> keyFrames(frames.data() + track.firstKey,
+                                         track.numKeys);
+
+  if (frame >= keyFrames.back()) {
+    *out = track.lastValue;
+    return;
+  }
+
+  const size_t f = FindKey(keyFrames, frame, cursor);
+  const float boundFrame = static_cast<float>(keyFrames[f]);
+  const float prevFrame = static_cast<float>(keyFrames[f - 1]);
+  const float delta = (prevFrame - frameDelta) / (prevFrame - boundFrame);
+  const Vector4A16 startPoint = Key(track.firstKey + f - 1);
+  const Vector4A16 endPoint = Key(track.firstKey + f);
+
+  switch (track.interpolation) {
+  case LMTKeyInterpolation::Linear:
+  case LMTKeyInterpolation::BoundedLinear:
+    *out = startPoint + (endPoint - startPoint) * delta;
+    break;
+  case LMTKeyInterpolation::Spherical:
+  case LMTKeyInterpolation::BoundedSpherical:
+    *out = slerp(startPoint, endPoint, delta);
+    break;
+  case LMTKeyInterpolation::Hermite: {
+    const Vector4A16 *tangs =
+        tangents.data() + track.firstTangent + (f - 1) * 2;
+    const float deltaP2 = delta * delta;
+    const float deltaP3 = delta * deltaP2;
+    const float deltaP32 = deltaP3 * 2;
+    const float deltaP23 = deltaP2 * 3;
+    const float h1 = deltaP32 - deltaP23 + 1;
+    const float h2 = -deltaP32 + deltaP23;
+    const float h3 = deltaP3 - 2 * deltaP2 + delta;
+    const float h4 = deltaP3 - deltaP2;
+
+    *out = startPoint * h1 + endPoint * h2 + tangs[0] * h3 + tangs[1] * h4;
+    break;
+  }
+  }
+}
+
+namespace revil {
+LMTPoseEvaluator::LMTPoseEvaluator(const LMTAnimation &animation,
+                                   float frameRate)
+    : pi(std::make_unique<LMTPoseEvaluatorImpl>(animation, frameRate)) {}
+LMTPoseEvaluator::LMTPoseEvaluator(LMTPoseEvaluator &&) = default;
+LMTPoseEvaluator::~LMTPoseEvaluator() = default;
+
+std::span<const LMTPoseBone> LMTPoseEvaluator::Bones() const {
+  return pi->bones;
+}
+
+float LMTPoseEvaluator::Duration() const { return pi->duration; }
+
+void LMTPoseEvaluator::Evaluate(LMTPose &pose, float time) const {
+  pi->Init(pose);
+
+  for (auto &t : pi->tracks) {
+    LMTTrackCursor cursor;
+    pi->Evaluate(t, pose, time, cursor);
+  }
+}
+
+void LMTPoseEvaluator::Evaluate(std::span<LMTPose> poses,
+                                std::span<const float> times) const {
+  for (size_t i = 0; i < times.size(); i++) {
+    pi->Init(poses[i]);
+  }
+
+  // Track major order keeps keys of single track in cache
+  for (auto &t : pi->tracks) {
+    LMTTrackCursor cursor;
+
+    for (size_t i = 0; i < times.size(); i++) {
+      pi->Evaluate(t, poses[i], times[i], cursor);
+    }
+  }
+}
+} // namespace revil
@@ -79,8 +79,8 @@ LMTAnimationInterface::Load(BinReaderRef_e rd,
   rd.Seek(0);
   rd.ReadContainer(*buff, bufferSize);
 
-  std::vector<void *> ptrStore;
-  LMTConstructorProperties cProps(props, ptrStore);
+  FixupRegistry fixups;
+  LMTConstructorProperties cProps(props, fixups);
 
   cProps.base = buff.get()->data();
   cProps.dataStart = cProps.base + dataStart;
@@ -93,19 +93,31 @@ LMTAnimationInterface::Load(BinReaderRef_e rd,
   return out;
 }
 
-void LMT::Load(BinReaderRef_e rd) {
+struct LMTHeader {
+  LMTVersion version;
+  bool isX64;
+  bool swapEndian = false;
+  uint16 numBlocks = 0;
+};
+
+// numBlocks is 0 for files without animations
+static LMTHeader ReadHeader(BinReaderRef_e rd) {
   uint32 magic;
   rd.Read(magic);
 
+  LMTHeader retVal;
+
+  // Reader is copied, caller gets endianness from header
   if (magic == TML_ID) {
     rd.SwapEndian(true);
+    retVal.swapEndian = true;
   } else if (magic != LMT_ID) {
     throw es::InvalidHeaderError(magic);
   }
 
   uint16 iversion;
   rd.Read(iversion);
-  LMTVersion version = static_cast<LMTVersion>(iversion);
+  retVal.version = static_cast<LMTVersion>(iversion);
 
   if (!LMTAnimation::SupportedVersion(iversion)) {
     throw es::InvalidVersionError(iversion);
@@ -115,10 +127,10 @@ void LMT::Load(BinReaderRef_e rd) {
   rd.Read(numBlocks);
 
   if (!numBlocks) {
-    return;
+    return retVal;
   }
 
-  if (version >= LMTVersion::V_92) {
+  if (retVal.version >= LMTVersion::V_92) {
     rd.Skip(8); // 0x17011700 v92, 0x18020800 v95
   }
 
@@ -132,7 +144,7 @@ void LMT::Load(BinReaderRef_e rd) {
 
   while (!magic) {
     if (rd.IsEOF()) {
-      return;
+      return retVal;
     }
 
     rd.Read(magic);
@@ -140,53 +152,82 @@ void LMT::Load(BinReaderRef_e rd) {
 
   rd.Seek(magic);
 
-  const bool isX64 = calcutatedSizeX64 != calcutatedSizeX86
-                         ? magic == calcutatedSizeX64
-                         : IsX64CompatibleAnimationClass(rd, version);
+  retVal.isX64 = calcutatedSizeX64 != calcutatedSizeX86
+                     ? magic == calcutatedSizeX64
+                     : IsX64CompatibleAnimationClass(rd, retVal.version);
+  retVal.numBlocks = numBlocks;
 
-  rd.Seek(0);
+  return retVal;
+}
 
-  const size_t fleSize = rd.GetSize();
-  const size_t multiplier = isX64 ? 2 : 1;
+// Lookup table is read by copy, buffer is not modified
+static std::vector<uint32> ReadOffsets(const char *buffer,
+                                       const LMTHeader &header,
+                                       bool swapEndian) {
   const size_t lookupTableOffset =
-      8 + (version >= LMTVersion::V_92 ? (4 * multiplier) : 0);
+      8 + (header.version >= LMTVersion::V_92 ? (header.isX64 ? 8 : 4) : 0);
+  const char *lookupTable = buffer + lookupTableOffset;
+  std::vector<uint32> retVal(header.numBlocks);
 
-  Version(version, isX64 ? LMTArchType::X64 : LMTArchType::X86);
-
-  rd.ReadContainer(pi->masterBuffer, fleSize);
-  char *buffer = &pi->masterBuffer[0];
+  for (uint32 a = 0; a < header.numBlocks; a++) {
+    if (header.isX64) {
+      uint64 cOffset;
+      memcpy(&cOffset, lookupTable + a * sizeof(uint64), sizeof(cOffset));
 
-  uint32 *lookupTable = reinterpret_cast<uint32 *>(buffer + lookupTableOffset);
-
-  pi->storage.resize(numBlocks);
-  std::vector<void *> ptrStore;
-
-  LMTConstructorProperties cProps(pi->props, ptrStore);
-  cProps.base = buffer;
-  cProps.swapEndian = rd.SwappedEndian();
+      if (swapEndian) {
+        FByteswapper(cOffset);
+      }
 
-  for (uint32 a = 0; a < numBlocks; a++) {
-    uint32 &cOffset = *(lookupTable + (a * multiplier));
+      retVal[a] = static_cast<uint32>(cOffset);
+    } else {
+      uint32 cOffset;
+      memcpy(&cOffset, lookupTable + a * sizeof(uint32), sizeof(cOffset));
 
-    if (rd.SwappedEndian()) {
-      if (isX64) {
-        FByteswapper(reinterpret_cast<int64 &>(cOffset));
-      } else {
+      if (swapEndian) {
         FByteswapper(cOffset);
       }
-    }
 
-    if (!cOffset) {
-      continue;
+      retVal[a] = cOffset;
     }
+  }
+
+  return retVal;
+}
+
+void LMT::Load(BinReaderRef_e rd) {
+  const LMTHeader header = ReadHeader(rd);
+
+  if (!header.numBlocks) {
+    return;
+  }
 
-    cProps.dataStart = buffer + cOffset;
+  rd.Seek(0);
+  Version(header.version,
+          header.isX64 ? LMTArchType::X64 : LMTArchType::X86);
+  rd.ReadContainer(pi->masterBuffer, rd.GetSize());
+  char *buffer = &pi->masterBuffer[0];
+  pi->InitBlocks(buffer, ReadOffsets(buffer, header, header.swapEndian),
+                 header.swapEndian);
+}
 
-    pi->storage[a] = uni::ToElement(LMTAnimation::Create(cProps));
+void LMT::LoadMapped(const std::string &fileName) {
+  BinReader rd(fileName);
+  const LMTHeader header = ReadHeader(rd);
+
+  if (!header.numBlocks) {
+    return;
   }
+
+  Version(header.version,
+          header.isX64 ? LMTArchType::X64 : LMTArchType::X86);
+  pi->mappedFile = MappedFile(fileName, true);
+  char *buffer = pi->mappedFile.MutableData();
+  pi->InitBlocks(buffer, ReadOffsets(buffer, header, header.swapEndian),
+                 header.swapEndian);
 }
 
 void LMT::Save(BinWritterRef wr) const {
+  pi->ConstructAll();
   wr.Write(LMT_ID);
   wr.Write(static_cast<uint16>(Version()));
   wr.Write(static_cast<uint16>(pi->storage.size()));
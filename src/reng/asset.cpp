@@ -43,8 +43,8 @@ void REAsset::Load(BinReaderRef rd) {
 void REAssetImpl::Load(BinReaderRef rd) {
   const size_t fleSize = rd.GetSize();
   rd.ReadContainer(internalBuffer, fleSize);
-  std::vector<void *> ptrStore;
-  Fixup(ptrStore);
+  FixupRegistry fixups;
+  Fixup(fixups);
 }
 
 void REAssetImpl::Assign(REAssetBase *data) {
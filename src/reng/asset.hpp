@@ -16,6 +16,7 @@
 */
 
 #pragma once
+#include "../fixup_registry.hpp"
 #include "revil/re_asset.hpp"
 #include "spike/type/pointer.hpp"
 #include "spike/uni/common.hpp"
@@ -46,7 +47,7 @@ public:
   void Load(BinReaderRef rd);
   static Ptr Create(REAssetBase base);
   void Assign(REAssetBase *data);
-  virtual void Fixup(std::vector<void *> &ptrStore) = 0;
+  virtual void Fixup(FixupRegistry &fixups) = 0;
   virtual void Build() = 0;
   virtual uni::BaseElementConst AsMotion() const { return {}; }
   virtual uni::BaseElementConst AsMotions() const { return {}; }
@@ -57,7 +58,7 @@ public:
 class ProcessFlags {
 public:
   char *base;
-  std::vector<void *> *ptrStore;
+  FixupRegistry *fixups;
 };
 
 template <class C> void RE_EXTERN ProcessClass(C &input, ProcessFlags flags);
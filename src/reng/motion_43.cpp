@@ -18,18 +18,18 @@
 #include "motion_43.hpp"
 
 template <> void ProcessClass(REMotionBone &item, ProcessFlags flags) {
-  es::FixupPointers(flags.base, *flags.ptrStore, item.boneName,
-                    item.parentBoneNamePtr, item.firstChildBoneNamePtr,
-                    item.lastChildBoneNamePtr);
+  flags.fixups->FixupPointers(flags.base, item.boneName, item.parentBoneNamePtr,
+                              item.firstChildBoneNamePtr,
+                              item.lastChildBoneNamePtr);
 }
 
 template <> void ProcessClass(RETrackCurve43 &item, ProcessFlags flags) {
-  es::FixupPointers(flags.base, *flags.ptrStore, item.frames,
-                    item.controlPoints, item.minMaxBounds);
+  flags.fixups->FixupPointers(flags.base, item.frames, item.controlPoints,
+                              item.minMaxBounds);
 }
 
 template <> void ProcessClass(REMotionTrack43 &item, ProcessFlags flags) {
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.curves)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.curves)) {
     return;
   }
 
@@ -44,8 +44,8 @@ template <> void ProcessClass(REMotionTrack43 &item, ProcessFlags flags) {
 
 template <> void ProcessClass(REMotion43 &item, ProcessFlags flags) {
   flags.base = reinterpret_cast<char *>(&item);
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.bones, item.tracks,
-                         item.unkOffset02, item.animationName)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.bones, item.tracks,
+                                   item.unkOffset02, item.animationName)) {
     return;
   }
 
@@ -173,9 +173,9 @@ void REMotion43Asset::Build() {
   }
 }
 
-void REMotion43Asset::Fixup(std::vector<void *> &ptrStore) {
+void REMotion43Asset::Fixup(FixupRegistry &fixups) {
   ProcessFlags flags;
-  flags.ptrStore = &ptrStore;
+  flags.fixups = &fixups;
   ProcessClass(Get(), flags);
   Build();
 }
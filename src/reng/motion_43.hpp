@@ -147,7 +147,7 @@ public:
     return uni::Element<const uni::Motion>{this, false};
   }
 
-  void Fixup(std::vector<void *> &ptrStore) override;
+  void Fixup(FixupRegistry &fixups) override;
   void Build() override;
 
 public:
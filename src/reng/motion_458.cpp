@@ -19,8 +19,8 @@
 
 template <> void ProcessClass(REMotion458 &item, ProcessFlags flags) {
   flags.base = reinterpret_cast<char *>(&item);
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.tracks,
-                         item.animationName)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.tracks,
+                                   item.animationName)) {
     return;
   }
 
@@ -68,9 +68,9 @@ void REMotion458Asset::Build() {
   }
 }
 
-void REMotion458Asset::Fixup(std::vector<void *> &ptrStore) {
+void REMotion458Asset::Fixup(FixupRegistry &fixups) {
   ProcessFlags flags;
-  flags.ptrStore = &ptrStore;
+  flags.fixups = &fixups;
   ProcessClass(Get(), flags);
   Build();
 }
@@ -22,7 +22,7 @@ template <> void ProcessClass(RETrackCurve65 &item, ProcessFlags flags) {
 }
 
 template <> void ProcessClass(REMotionTrack65 &item, ProcessFlags flags) {
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.curves)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.curves)) {
     return;
   }
 
@@ -37,8 +37,8 @@ template <> void ProcessClass(REMotionTrack65 &item, ProcessFlags flags) {
 
 template <> void ProcessClass(REMotion65 &item, ProcessFlags flags) {
   flags.base = reinterpret_cast<char *>(&item);
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.bones, item.tracks,
-                         item.unkOffset02, item.animationName)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.bones, item.tracks,
+                                   item.unkOffset02, item.animationName)) {
     return;
   }
 
@@ -94,9 +94,9 @@ void REMotion65Asset::Build() {
   }
 }
 
-void REMotion65Asset::Fixup(std::vector<void *> &ptrStore) {
+void REMotion65Asset::Fixup(FixupRegistry &fixups) {
   ProcessFlags flags;
-  flags.ptrStore = &ptrStore;
+  flags.fixups = &fixups;
   ProcessClass(Get(), flags);
   Build();
 }
@@ -18,12 +18,12 @@
 #include "motion_78.hpp"
 
 template <> void ProcessClass(RETrackCurve78 &item, ProcessFlags flags) {
-  es::FixupPointers(flags.base, *flags.ptrStore, item.frames,
-                    item.controlPoints, item.minMaxBounds);
+  flags.fixups->FixupPointers(flags.base, item.frames, item.controlPoints,
+                              item.minMaxBounds);
 }
 
 template <> void ProcessClass(REMotionTrack78 &item, ProcessFlags flags) {
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.curves)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.curves)) {
     return;
   }
 
@@ -38,8 +38,8 @@ template <> void ProcessClass(REMotionTrack78 &item, ProcessFlags flags) {
 
 template <> void ProcessClass(REMotion78 &item, ProcessFlags flags) {
   flags.base = reinterpret_cast<char *>(&item);
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.tracks,
-                         item.unkOffset02, item.animationName)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.tracks, item.unkOffset02,
+                                   item.animationName)) {
     return;
   }
 
@@ -87,9 +87,9 @@ void REMotion78Asset::Build() {
   }
 }
 
-void REMotion78Asset::Fixup(std::vector<void *> &ptrStore) {
+void REMotion78Asset::Fixup(FixupRegistry &fixups) {
   ProcessFlags flags;
-  flags.ptrStore = &ptrStore;
+  flags.fixups = &fixups;
   ProcessClass(Get(), flags);
   Build();
 }
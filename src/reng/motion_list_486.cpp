@@ -20,15 +20,15 @@
 template <> void ProcessClass(REMotlist486 &item, ProcessFlags flags) {
   flags.base = reinterpret_cast<char *>(&item);
 
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.motions,
-                         item.unkOffset00, item.fileName, item.null)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.motions, item.unkOffset00,
+                                   item.fileName, item.null)) {
     return;
   }
 
   auto motions = item.motions.operator->();
 
   for (uint32 m = 0; m < item.numMotions; m++) {
-    motions[m].Fixup(flags.base, *flags.ptrStore);
+    flags.fixups->FixupOnce(motions[m], flags.base);
 
     REAssetBase *cMotBase = motions[m];
 
@@ -47,8 +47,8 @@ template <> void ProcessClass(REMotlist486 &item, ProcessFlags flags) {
 
     auto nFlags = flags;
     nFlags.base = reinterpret_cast<char *>(cMot);
-    cMot->bones.Fixup(nFlags.base, *nFlags.ptrStore);
-    cMot->bones->ptr.Fixup(nFlags.base, *nFlags.ptrStore);
+    nFlags.fixups->FixupOnce(cMot->bones, nFlags.base);
+    nFlags.fixups->FixupOnce(cMot->bones->ptr, nFlags.base);
     REMotionBone *bonesPtr = cMot->bones->ptr;
 
     if (!bonesPtr) {
@@ -87,9 +87,9 @@ void REMotlist486Asset::Build() {
   }
 }
 
-void REMotlist486Asset::Fixup(std::vector<void *> &ptrStore) {
+void REMotlist486Asset::Fixup(FixupRegistry &fixups) {
   ProcessFlags flags;
-  flags.ptrStore = &ptrStore;
+  flags.fixups = &fixups;
   ProcessClass(Get(), flags);
   Build();
 }
@@ -88,7 +88,7 @@ class REMotlist60Asset : public REAssetImpl,
     return {static_cast<const MotionList60 *>(this), false};
   }
 
-  void Fixup(std::vector<void *> &ptrStore) override;
+  void Fixup(FixupRegistry &fixups) override;
   void Build() override;
 
 public:
@@ -20,15 +20,15 @@
 template <> void ProcessClass(REMotlist85 &item, ProcessFlags flags) {
   flags.base = reinterpret_cast<char *>(&item);
 
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.motions,
-                         item.unkOffset00, item.fileName, item.null)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.motions, item.unkOffset00,
+                                   item.fileName, item.null)) {
     return;
   }
 
   auto motions = item.motions.operator->();
 
   for (uint32 m = 0; m < item.numMotions; m++) {
-    motions[m].Fixup(flags.base, *flags.ptrStore);
+    flags.fixups->FixupOnce(motions[m], flags.base);
 
     REAssetBase *cMotBase = motions[m];
 
@@ -76,9 +76,9 @@ void REMotlist85Asset::Build() {
   }
 }
 
-void REMotlist85Asset::Fixup(std::vector<void *> &ptrStore) {
+void REMotlist85Asset::Fixup(FixupRegistry &fixups) {
   ProcessFlags flags;
-  flags.ptrStore = &ptrStore;
+  flags.fixups = &fixups;
   ProcessClass(Get(), flags);
   Build();
 }
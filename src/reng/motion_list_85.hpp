@@ -46,7 +46,7 @@ class REMotlist85Asset : public REAssetImpl,
     return {static_cast<const MotionList85 *>(this), false};
   }
 
-  void Fixup(std::vector<void *> &ptrStore) override;
+  void Fixup(FixupRegistry &fixups) override;
   void Build() override;
 
 public:
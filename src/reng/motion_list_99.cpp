@@ -21,15 +21,15 @@
 template <> void ProcessClass(REMotlist99 &item, ProcessFlags flags) {
   flags.base = reinterpret_cast<char *>(&item);
 
-  if (!es::FixupPointers(flags.base, *flags.ptrStore, item.motions,
-                         item.unkOffset00, item.fileName, item.null)) {
+  if (!flags.fixups->FixupPointers(flags.base, item.motions, item.unkOffset00,
+                                   item.fileName, item.null)) {
     return;
   }
 
   auto motions = item.motions.operator->();
 
   for (uint32 m = 0; m < item.numMotions; m++) {
-    motions[m].Fixup(flags.base, *flags.ptrStore);
+    flags.fixups->FixupOnce(motions[m], flags.base);
 
     REAssetBase *cMotBase = motions[m];
 
@@ -48,8 +48,8 @@ template <> void ProcessClass(REMotlist99 &item, ProcessFlags flags) {
 
     auto nFlags = flags;
     nFlags.base = reinterpret_cast<char *>(cMot);
-    cMot->bones.Fixup(nFlags.base, *flags.ptrStore);
-    cMot->bones->ptr.Fixup(nFlags.base, *flags.ptrStore);
+    flags.fixups->FixupOnce(cMot->bones, nFlags.base);
+    flags.fixups->FixupOnce(cMot->bones->ptr, nFlags.base);
     REMotionBone *bonesPtr = cMot->bones->ptr;
 
     if (!bonesPtr) {
@@ -88,9 +88,9 @@ void REMotlist99Asset::Build() {
   }
 }
 
-void REMotlist99Asset::Fixup(std::vector<void *> &ptrStore) {
+void REMotlist99Asset::Fixup(FixupRegistry &fixups) {
   ProcessFlags flags;
-  flags.ptrStore = &ptrStore;
+  flags.fixups = &fixups;
   ProcessClass(Get(), flags);
   Build();
 }
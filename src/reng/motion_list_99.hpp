@@ -41,7 +41,7 @@ class REMotlist99Asset : public REAssetImpl,
     return {static_cast<const MotionList99 *>(this), false};
   }
 
-  void Fixup(std::vector<void *> &ptrStore) override;
+  void Fixup(FixupRegistry &fixups) override;
   void Build() override;
 
 public:
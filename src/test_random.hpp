@@ -0,0 +1,33 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "spike/util/supercore.hpp"
+#include <span>
+
+// Linear congruential generator, same seed gives same data on every platform
+struct TestRandom {
+  uint32 seed;
+
+  uint32 Next() { return seed = seed * 1103515245 + 12345; }
+
+  void Fill(std::span<char> buffer) {
+    for (auto &c : buffer) {
+      c = static_cast<char>(Next() >> 16);
+    }
+  }
+};
@@ -18,11 +18,13 @@
 #include "revil/tex.hpp"
 #include "pvr_decompress.hpp"
 #include "spike/except.hpp"
-#include "spike/gpu/addr_ps3.hpp"
 #include "spike/io/binreader_stream.hpp"
 #include "spike/io/binwritter_stream.hpp"
 #include "spike/type/bitfield.hpp"
+#include "tex_swizzle.hpp"
+#include <atomic>
 #include <map>
+#include <span>
 #include <vector>
 
 using namespace revil;
@@ -349,43 +351,197 @@ DDS_HeaderDX10 ConvertTEXFormat(TEXFormatV2PS4 fmt) {
   }
 }
 
-size_t AddrPS4(size_t x, size_t y, size_t width) {
-  const size_t x0 = x & 1;
-  const size_t x1 = (x & 2) << 1;
-  const size_t x2 = (x & 4) << 2;
+enum class TEXDecode : uint8 {
+  None,
+  PS3Morton,
+  PS4Tiled,
+  PVRTC4,
+  ETC1,
+};
 
-  const size_t y0 = (y & 1) << 1;
-  const size_t y1 = (y & 2) << 2;
-  const size_t y2 = (y & 4) << 3;
+enum class TEXPixelFix : uint8 {
+  None,
+  BC5SNorm,
+  RG8SNorm,
+  RGBA4Android,
+};
 
-  size_t retval = x0 | x1 | x2 | y0 | y1 | y2;
+struct revil::TEXDeferred {
+  TEXDecode decode = TEXDecode::None;
+  TEXPixelFix fix = TEXPixelFix::None;
+  // Tiled or compressed pixels, buffer holds stored pixels when empty
+  std::string source;
+  // PVRTC and ETC1 mip offsets within source, last one is source end
+  std::vector<size_t> sourceOffsets;
+  size_t numMips = 1;
+  size_t numSlices = 0;
+  size_t sliceSize = 0;
+  size_t numTasks = 0;
+  std::atomic_size_t remainingTasks{0};
+  // PS4 base level in blocks
+  size_t tiledWidth = 0;
+  size_t tiledHeight = 0;
+  size_t blockSize = 0;
+  // Header only load, stored pixels are left in stream
+  bool headerOnly = false;
+  // Auto when loader keeps requested platform
+  Platform platform = Platform::Auto;
+  // Stream offset of stored pixels or source
+  uint64 dataOffset = 0;
+  size_t storedSize = 0;
+  // Cubemap surfaces, ordered [face][mip]
+  std::vector<uint64> surfaceOffsets;
+};
 
-  const size_t macroX = x / 8;
-  const size_t macroY = y / 8;
-  const size_t macroWidth = width / 8;
+static void FixPixels(TEXPixelFix fix, std::span<char> data) {
+  if (fix == TEXPixelFix::BC5SNorm) {
+    struct BlockType {
+      union {
+        struct {
+          int8 minS;
+          int8 maxS;
+        };
+        struct {
+          uint8 minU;
+          uint8 maxU;
+        };
+      };
 
-  const size_t macroAddr = (macroWidth * macroY) + macroX;
+      uint16 nibblesCont;
+      uint32 nibbles;
+    };
 
-  return retval | (macroAddr << 6);
+    const size_t stride = sizeof(BlockType);
+
+    for (size_t p = 0; p + stride <= data.size(); p += stride) {
+      BlockType tmpBlock;
+      memcpy(&tmpBlock, data.data() + p, sizeof(tmpBlock));
+      tmpBlock.minU = std::max(tmpBlock.minS, int8(0)) * 2;
+      tmpBlock.maxU = std::max(tmpBlock.maxS, int8(0)) * 2;
+      memcpy(data.data() + p, &tmpBlock, sizeof(tmpBlock));
+    }
+  } else if (fix == TEXPixelFix::RG8SNorm) {
+    const size_t stride = sizeof(__m128i);
+    const size_t numLoops = data.size() / stride;
+    const __m128i xmn = _mm_set1_epi8(0x80);
+
+    for (size_t i = 0; i < numLoops; i++) {
+      char *chunk = data.data() + i * stride;
+      __m128i xmm = _mm_loadu_si128(reinterpret_cast<const __m128i *>(chunk));
+      xmm = _mm_add_epi8(xmm, xmn);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(chunk), xmm);
+    }
+
+    // Task owns only its own bytes, rest must not be loaded as vector
+    for (size_t i = numLoops * stride; i < data.size(); i++) {
+      data[i] = char(uint8(data[i]) + 0x80);
+    }
+  } else if (fix == TEXPixelFix::RGBA4Android) {
+    const size_t stride = sizeof(uint16);
+    const size_t numLoops = data.size() / stride;
+
+    for (size_t i = 0; i < numLoops; i++) {
+      uint16 texel;
+      memcpy(&texel, data.data() + i * stride, stride);
+      texel = texel >> 4 | texel << 12;
+      memcpy(data.data() + i * stride, &texel, stride);
+    }
+  }
 }
 
-struct TEXInternal : TEX {
-  void ConvertBuffer(Platform platform) {
+// Converts stored surface into data, stored is empty for in place fixes
+static void ConvertSurface(const TEXDeferred &pending, size_t index,
+                           std::span<const char> stored, std::span<char> data,
+                           uint32 width, uint32 height) {
+  switch (pending.decode) {
+  case TEXDecode::PS3Morton:
+    DeswizzlePS3RGBA8(stored, data, std::max(width, 1U),
+                      std::max(height, 1U));
+    break;
+
+  case TEXDecode::PS4Tiled:
+    // Only base level of first slice is detiled, rest is kept as stored
+    if (index == 0) {
+      const size_t linearSize =
+          std::min(pending.tiledWidth * pending.tiledHeight * pending.blockSize,
+                   data.size());
+      DeswizzlePS4(stored, data.first(linearSize), pending.tiledWidth,
+                   pending.tiledHeight, pending.blockSize);
+      memcpy(data.data() + linearSize, stored.data() + linearSize,
+             data.size() - linearSize);
+    } else {
+      memcpy(data.data(), stored.data(), data.size());
+    }
+    break;
+
+  case TEXDecode::PVRTC4:
+    pvrrvl::PVRTDecompressPVRTC(stored.data(), 0, width, height,
+                                reinterpret_cast<uint8 *>(data.data()));
+    break;
+
+  case TEXDecode::ETC1:
+    pvrrvl::PVRTDecompressETC(stored.data(), width, height, data.data(), 0);
+    break;
+
+  default:
+    if (!stored.empty()) {
+      memcpy(data.data(), stored.data(), data.size());
+    }
+    break;
+  }
+
+  FixPixels(pending.fix, data);
+}
+
+struct revil::TEXInternal : TEX {
+  std::shared_ptr<TEXDeferred> pending = std::make_shared<TEXDeferred>();
+  // Linear pixels of all slices
+  size_t pixelsSize = 0;
+
+  explicit TEXInternal(bool headerOnly) { pending->headerOnly = headerOnly; }
+
+  static std::shared_ptr<TEXDeferred> &Deferred(TEX &tex) {
+    return tex.deferred;
+  }
+
+  // Header only loads only remember where pixels begin
+  void ReadPixels(BinReaderRef_e rd, size_t size) {
+    pixelsSize = size;
+
+    if (pending->headerOnly) {
+      pending->dataOffset = rd.Tell();
+    } else {
+      rd.ReadContainer(buffer, size);
+    }
+  }
+
+  // Returns false for header only loads, layout is kept for streaming
+  bool ComputeLayout() {
+    pending->numMips = std::max<size_t>(asDDS.mipMapCount, 1);
+    const size_t lastMip = pending->numMips - 1;
+    pending->sliceSize = mips.offsets[lastMip] + mips.sizes[lastMip];
+    pending->storedSize = pixelsSize;
+
+    if (pending->sliceSize) {
+      pending->numSlices = pixelsSize / pending->sliceSize;
+    }
+
+    if (pending->headerOnly) {
+      deferred = std::move(pending);
+      return false;
+    }
+
+    return true;
+  }
+
+  // Decides conversion of loaded buffer, pixels are converted by tasks
+  void Defer(Platform platform) {
+    pending->platform = platform;
+
     if (asDDS.dxgiFormat == DXGI_FORMAT_R8G8B8A8_UNORM &&
         platform == Platform::PS3 && IsPow2(asDDS.width) &&
         IsPow2(asDDS.height)) {
-      std::string oldBuffer = buffer;
-      MortonSettings mset(asDDS.width, asDDS.height);
-      const size_t stride = sizeof(uint32);
-
-      for (size_t p = 0; p < buffer.size(); p += stride) {
-        const size_t coord = p >> 2;
-        const size_t x = coord % asDDS.width;
-        const size_t y = coord / asDDS.width;
-        memcpy(&buffer[p], oldBuffer.data() + MortonAddr(x, y, mset) * stride,
-               stride);
-        FByteswapper(reinterpret_cast<uint32 &>(buffer[p]));
-      }
+      pending->decode = TEXDecode::PS3Morton;
     } else if (platform == Platform::PS4) {
       size_t blockSize = 0;
       size_t width = asDDS.width;
@@ -403,104 +559,118 @@ struct TEXInternal : TEX {
         blockSize = asDDS.bpp / 8;
       }
 
-      auto widthp2 = std::max(width, size_t(8));
-
-      widthp2--;
-      widthp2 |= widthp2 >> 1;
-      widthp2 |= widthp2 >> 2;
-      widthp2 |= widthp2 >> 4;
-      widthp2 |= widthp2 >> 8;
-      widthp2 |= widthp2 >> 16;
-      widthp2++;
-
-      auto heightp2 = std::max(height, size_t(8));
-
-      heightp2--;
-      heightp2 |= heightp2 >> 1;
-      heightp2 |= heightp2 >> 2;
-      heightp2 |= heightp2 >> 4;
-      heightp2 |= heightp2 >> 8;
-      heightp2 |= heightp2 >> 16;
-      heightp2++;
-
-      std::string oldBuffer = buffer;
-
-      for (size_t h = 0; h < height; h++) {
-        for (size_t w = 0; w < width; w++) {
-          auto addr = AddrPS4(w, h, widthp2);
-          memcpy(buffer.data() + ((width * h) + w) * blockSize,
-                 oldBuffer.data() + addr * blockSize, blockSize);
-        }
-      }
+      pending->decode = TEXDecode::PS4Tiled;
+      pending->tiledWidth = width;
+      pending->tiledHeight = height;
+      pending->blockSize = blockSize;
     }
 
     if (asDDS.dxgiFormat == DXGI_FORMAT_BC5_SNORM) {
-      struct BlockType {
-        union {
-          struct {
-            int8 minS;
-            int8 maxS;
-          };
-          struct {
-            uint8 minU;
-            uint8 maxU;
-          };
-        };
+      pending->fix = TEXPixelFix::BC5SNorm;
+      asDDS.dxgiFormat = DXGI_FORMAT_BC5_UNORM;
+    } else if (asDDS.dxgiFormat == DXGI_FORMAT_R8G8_SNORM) {
+      pending->fix = TEXPixelFix::RG8SNorm;
+      asDDS.dxgiFormat = DXGI_FORMAT_R8G8_UNORM;
+    } else if (platform == Platform::Android && asDDS == DDSFormat_A4R4G4B4) {
+      pending->fix = TEXPixelFix::RGBA4Android;
+    }
 
-        uint16 nibblesCont;
-        uint32 nibbles;
-      };
+    if (!ComputeLayout()) {
+      return;
+    }
 
-      const size_t stride = sizeof(BlockType);
+    if (pending->decode == TEXDecode::None &&
+        pending->fix == TEXPixelFix::None) {
+      return;
+    }
 
-      for (size_t p = 0; p < buffer.size(); p += stride) {
-        BlockType tmpBlock;
-        memcpy(&tmpBlock, buffer.data() + p, sizeof(tmpBlock));
-        tmpBlock.minU = std::max(tmpBlock.minS, int8(0)) * 2;
-        tmpBlock.maxU = std::max(tmpBlock.maxS, int8(0)) * 2;
-        memcpy(buffer.data() + p, &tmpBlock, sizeof(tmpBlock));
-      }
+    pending->numTasks = pending->numSlices * pending->numMips;
+    pending->remainingTasks = pending->numTasks;
 
-      asDDS.dxgiFormat = DXGI_FORMAT_BC5_UNORM;
-    } else if (asDDS.dxgiFormat == DXGI_FORMAT_R8G8_SNORM) {
-      const size_t stride = sizeof(__m128i);
-      const size_t numLoops = buffer.size() / stride;
-      const size_t restBytes = buffer.size() % stride;
-
-      auto process = [](const char *data) {
-        __m128i xmm = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
-        const __m128i xmn = _mm_set1_epi8(0x80);
-        return _mm_add_epi8(xmm, xmn);
-      };
+    // Stored data is shorter than single slice, it is kept as is
+    if (!pending->numTasks) {
+      return;
+    }
 
-      for (size_t i = 0; i < numLoops; i++) {
-        const size_t index = i * stride;
-        const __m128i value = process(buffer.data() + index);
-        memcpy(&buffer[index], &value, stride);
+    if (pending->decode == TEXDecode::PS3Morton ||
+        pending->decode == TEXDecode::PS4Tiled) {
+      pending->source = std::move(buffer);
+      buffer.assign(pending->source.size(), '\0');
+
+      // Bytes past the last whole slice are not covered by tasks
+      const size_t tasksEnd = pending->numSlices * pending->sliceSize;
+      memcpy(buffer.data() + tasksEnd, pending->source.data() + tasksEnd,
+             buffer.size() - tasksEnd);
+
+      if (pending->decode == TEXDecode::PS4Tiled) {
+        // Tiles past the end of stored data are blank
+        pending->source.resize(
+            std::max(pending->source.size(),
+                     PS4TiledSize(pending->tiledWidth, pending->tiledHeight,
+                                  pending->blockSize)));
       }
+    }
 
-      if (restBytes) {
-        const size_t index = numLoops * stride;
-        const __m128i value = process(buffer.data() + index);
-        memcpy(&buffer[index], &value, restBytes);
+    deferred = std::move(pending);
+  }
+
+  /*
+  Both TEX and DDS store cubemap faces one after another, every face with
+  its whole mip chain. Surfaces are read straight into their DDS position,
+  offsets are absolute and ordered [face][mip].
+  */
+  template <class C>
+  void ReadCubemap(BinReaderRef_e rd, const C &offsets, size_t numFaces) {
+    asDDS.caps01 = decltype(asDDS.caps01)(
+        DDS::Caps01Flags_CubeMap, DDS::Caps01Flags_CubeMap_NegativeX,
+        DDS::Caps01Flags_CubeMap_NegativeY, DDS::Caps01Flags_CubeMap_NegativeZ,
+        DDS::Caps01Flags_CubeMap_PositiveX, DDS::Caps01Flags_CubeMap_PositiveY,
+        DDS::Caps01Flags_CubeMap_PositiveZ);
+    asDDS.ComputeBPP();
+    const size_t faceSize = asDDS.ComputeBufferSize(mips);
+    const size_t numMips = std::max<size_t>(asDDS.mipMapCount, 1);
+    const size_t numSurfaces = numFaces * numMips;
+
+    if (offsets.size() < numSurfaces) {
+      throw std::runtime_error("Cubemap surface offsets are truncated.");
+    }
+
+    pixelsSize = faceSize * numFaces;
+
+    if (pending->headerOnly) {
+      pending->surfaceOffsets.assign(offsets.begin(),
+                                     offsets.begin() + numSurfaces);
+      return;
+    }
+
+    buffer.resize(pixelsSize);
+    bool packed = true;
+
+    for (size_t f = 0; f < numFaces; f++) {
+      for (size_t m = 0; m < numMips; m++) {
+        packed &= offsets[f * numMips + m] ==
+                  offsets[0] + f * faceSize + mips.offsets[m];
       }
+    }
 
-      asDDS.dxgiFormat = DXGI_FORMAT_R8G8_UNORM;
-    } else if (platform == Platform::Android && asDDS == DDSFormat_A4R4G4B4) {
-      const size_t stride = sizeof(uint16);
-      const size_t numLoops = buffer.size() / stride;
+    if (packed) {
+      rd.Seek(offsets[0]);
+      rd.ReadBuffer(buffer.data(), buffer.size());
+      return;
+    }
 
-      for (size_t i = 0; i < numLoops; i++) {
-        const size_t index = i * stride;
-        uint16 &data = *reinterpret_cast<uint16 *>(buffer.data() + index);
-        data = data >> 4 | data << 12;
+    for (size_t f = 0; f < numFaces; f++) {
+      for (size_t m = 0; m < numMips; m++) {
+        rd.Seek(offsets[f * numMips + m]);
+        rd.ReadBuffer(buffer.data() + f * faceSize + mips.offsets[m],
+                      mips.sizes[m]);
       }
     }
   }
 };
 
-TEX LoadTEXx56(BinReaderRef_e rd) {
-  TEXInternal main;
+TEX LoadTEXx56(BinReaderRef_e rd, bool headerOnly) {
+  TEXInternal main(headerOnly);
   TEXx56 header;
   rd.Read(header);
 
@@ -531,15 +701,15 @@ TEX LoadTEXx56(BinReaderRef_e rd) {
     bufferSize *= header.arraySize;
   }
 
-  rd.ReadContainer(main.buffer, bufferSize);
-  main.ConvertBuffer(Platform::Win32);
+  main.ReadPixels(rd, bufferSize);
+  main.Defer(Platform::Win32);
 
   return main;
 }
 
 template <class header_type>
-TEX LoadTEXx66(BinReaderRef_e rd, Platform platform) {
-  TEXInternal main;
+TEX LoadTEXx66(BinReaderRef_e rd, Platform platform, bool headerOnly) {
+  TEXInternal main(headerOnly);
   header_type header;
   rd.Read(header);
 
@@ -557,12 +727,22 @@ TEX LoadTEXx66(BinReaderRef_e rd, Platform platform) {
   if (type == TextureType::Volume) {
     main.asDDS.caps01 += DDS_HeaderEnd::Caps01Flags_Volume;
   } else if (type == TextureType::Cubemap) {
-    throw std::runtime_error("Cubemaps are not supported.");
+    rd.Skip(sizeof(TEXCubemapData));
   }
 
   std::vector<uint32> offsets;
   rd.ReadContainer(offsets, header.numFaces * header.numMips);
 
+  if (type == TextureType::Cubemap) {
+    if (platform == Platform::PS4) {
+      throw std::runtime_error("PS4 cubemaps are not supported.");
+    }
+
+    main.ReadCubemap(rd, offsets, header.numFaces);
+    main.Defer(platform);
+    return main;
+  }
+
   main.asDDS.ComputeBPP();
   size_t bufferSize = main.asDDS.ComputeBufferSize(main.mips);
 
@@ -570,14 +750,14 @@ TEX LoadTEXx66(BinReaderRef_e rd, Platform platform) {
     bufferSize *= header.arraySize;
   }
 
-  rd.ReadContainer(main.buffer, bufferSize);
-  main.ConvertBuffer(platform);
+  main.ReadPixels(rd, bufferSize);
+  main.Defer(platform);
 
   return main;
 }
 
-TEX LoadTEXx87(BinReaderRef_e rd, Platform) {
-  TEXInternal main;
+TEX LoadTEXx87(BinReaderRef_e rd, Platform, bool headerOnly) {
+  TEXInternal main(headerOnly);
   TEXx87 header;
   rd.Read(header);
   using t = TEXx87;
@@ -591,31 +771,42 @@ TEX LoadTEXx87(BinReaderRef_e rd, Platform) {
 
   TextureTypeV2 type = (TextureTypeV2)header.tier0.Get<t::TextureType>();
 
+  const bool isCubemap = type == TextureTypeV2::Cubemap;
+  const uint32 numFaces = header.tier0.Get<t::NumFaces>();
+
   if (type == TextureTypeV2::Volume) {
     main.asDDS.caps01 += DDS_HeaderEnd::Caps01Flags_Volume;
-  } else if (type == TextureTypeV2::Cubemap) {
-    throw std::runtime_error("Cubemaps are not supported.");
+  } else if (isCubemap) {
+    rd.Skip(sizeof(TEXCubemapData));
   }
 
-  uint32 numOffsets = main.asDDS.depth * main.asDDS.mipMapCount;
+  uint32 numOffsets =
+      (isCubemap ? numFaces : main.asDDS.depth) * main.asDDS.mipMapCount;
 
   std::vector<uint32> offsets;
   rd.ReadContainer(offsets, numOffsets);
 
-  main.asDDS.ComputeBPP();
-  size_t bufferSize = main.asDDS.ComputeBufferSize(main.mips);
+  if (isCubemap) {
+    main.ReadCubemap(rd, offsets, numFaces);
+  } else {
+    main.asDDS.ComputeBPP();
+    size_t bufferSize = main.asDDS.ComputeBufferSize(main.mips);
 
-  if (main.asDDS.depth) {
-    bufferSize *= main.asDDS.depth;
+    if (main.asDDS.depth) {
+      bufferSize *= main.asDDS.depth;
+    }
+
+    main.ReadPixels(rd, bufferSize);
   }
 
-  rd.ReadContainer(main.buffer, bufferSize);
+  // Pixels are used as stored on every platform, there is nothing to defer
+  main.ComputeLayout();
 
   return main;
 }
 
-TEX LoadTEXx9D(BinReaderRef_e rd, Platform platform) {
-  TEXInternal main;
+TEX LoadTEXx9D(BinReaderRef_e rd, Platform platform, bool headerOnly) {
+  TEXInternal main(headerOnly);
   TEXx9D header;
   rd.Read(header);
   using t = TEXx9D;
@@ -628,17 +819,23 @@ TEX LoadTEXx9D(BinReaderRef_e rd, Platform platform) {
 
   TextureTypeV2 type = (TextureTypeV2)header.tier0.Get<t::TextureType>();
 
+  const bool isCubemap = type == TextureTypeV2::Cubemap;
+  const uint32 numFaces = header.tier2.Get<t::NumFaces>();
+
   if (type == TextureTypeV2::Volume) {
     main.asDDS.caps01 += DDS_HeaderEnd::Caps01Flags_Volume;
-  } else if (type == TextureTypeV2::Cubemap) {
-    throw std::runtime_error("Cubemaps are not supported.");
+  } else if (isCubemap) {
+    rd.Skip(sizeof(TEXCubemapData));
   }
 
-  uint32 numOffsets = main.asDDS.depth * main.asDDS.mipMapCount;
+  uint32 numOffsets =
+      (isCubemap ? numFaces : main.asDDS.depth) * main.asDDS.mipMapCount;
+  std::vector<uint64> offsets;
 
   auto fallback = [&] {
-    std::vector<uint32> offsets;
-    rd.ReadContainer(offsets, numOffsets);
+    std::vector<uint32> offsets32;
+    rd.ReadContainer(offsets32, numOffsets);
+    offsets.assign(offsets32.begin(), offsets32.end());
     main.asDDS =
         ConvertTEXFormat((TEXFormatV2)header.tier2.Get<t::TextureFormat>());
   };
@@ -653,7 +850,6 @@ TEX LoadTEXx9D(BinReaderRef_e rd, Platform platform) {
     if (offset0 == dataBeginPredict) {
       fallback();
     } else {
-      std::vector<uint64> offsets;
       rd.ReadContainer(offsets, numOffsets);
       platform = Platform::PS4;
       main.asDDS = ConvertTEXFormat(
@@ -663,6 +859,17 @@ TEX LoadTEXx9D(BinReaderRef_e rd, Platform platform) {
     fallback();
   }
 
+  if (isCubemap) {
+    // Every face is tiled on its own, tasks detile only the first surface
+    if (platform == Platform::PS4) {
+      throw std::runtime_error("PS4 cubemaps are not supported.");
+    }
+
+    main.ReadCubemap(rd, offsets, numFaces);
+    main.Defer(platform);
+    return main;
+  }
+
   main.asDDS.ComputeBPP();
   size_t bufferSize = main.asDDS.ComputeBufferSize(main.mips);
 
@@ -670,15 +877,15 @@ TEX LoadTEXx9D(BinReaderRef_e rd, Platform platform) {
     bufferSize *= main.asDDS.depth;
   }
 
-  rd.ReadContainer(main.buffer, bufferSize);
-  main.ConvertBuffer(platform);
+  main.ReadPixels(rd, bufferSize);
+  main.Defer(platform);
 
   return main;
 }
 
-TEX LoadTEXx09(BinReaderRef_e rd_, Platform) {
+TEX LoadTEXx09(BinReaderRef_e rd_, Platform, bool headerOnly) {
   BinReaderRef rd(rd_);
-  TEXInternal main;
+  TEXInternal main(headerOnly);
   TEXx09 header;
   rd.Read(header);
 
@@ -686,58 +893,72 @@ TEX LoadTEXx09(BinReaderRef_e rd_, Platform) {
   main.asDDS.height = header.height;
   main.asDDS.NumMipmaps(header.numMips);
 
-  if (header.format == TEXFormatAndr::PVRTC4) {
+  // Mips are decoded by tasks, stored mip sizes are known up front
+  auto ReadCompressed = [&](TEXDecode decode, size_t sourceSize,
+                            uint32 minSize) {
+    TEXDeferred &pending = *main.pending;
     main.asDDS = DDSFormat_A8B8G8R8;
-    std::string buffer;
-    const size_t bufferSize = main.asDDS.ComputeBufferSize(main.mips);
-    main.buffer.resize(bufferSize);
-    rd.Seek(header.pvrtcOffset);
-    rd.ReadContainer(buffer, header.pvrtcSize);
-    size_t curOffset = 0;
+    main.pixelsSize = main.asDDS.ComputeBufferSize(main.mips);
+    pending.decode = decode;
 
-    for (size_t m = 0; m < header.numMips; m++) {
-      curOffset += pvrrvl::PVRTDecompressPVRTC(
-          buffer.data() + curOffset, 0, header.width / (1 << m),
-          header.height / (1 << m),
-          reinterpret_cast<uint8 *>(main.buffer.data() + main.mips.offsets[m]));
+    if (headerOnly) {
+      pending.dataOffset = rd.Tell();
+    } else {
+      main.buffer.resize(main.pixelsSize);
+      rd.ReadContainer(pending.source, sourceSize);
     }
-  } else if (header.format == TEXFormatAndr::ETC1) {
-    main.asDDS = DDSFormat_A8B8G8R8;
-    std::string buffer;
-    const size_t bufferSize = main.asDDS.ComputeBufferSize(main.mips);
-    main.buffer.resize(bufferSize);
-    rd.ReadContainer(buffer, rd.GetSize() - sizeof(header));
+
     size_t curOffset = 0;
 
-    for (size_t m = 0; m < header.numMips; m++) {
-      curOffset += pvrrvl::PVRTDecompressETC(
-          buffer.data() + curOffset, header.width / (1 << m),
-          header.height / (1 << m), main.buffer.data() + main.mips.offsets[m],
-          0);
+    for (size_t m = 0; m < std::max<size_t>(header.numMips, 1); m++) {
+      pending.sourceOffsets.push_back(curOffset);
+      // 4 bits per texel, mips are padded to minSize
+      curOffset += size_t(std::max(uint32(header.width) >> m, minSize)) *
+                   std::max(uint32(header.height) >> m, minSize) / 2;
     }
+
+    pending.sourceOffsets.push_back(curOffset);
+
+    if (curOffset > sourceSize) {
+      throw std::runtime_error("Compressed texture is truncated.");
+    }
+  };
+
+  if (header.format == TEXFormatAndr::PVRTC4) {
+    rd.Seek(header.pvrtcOffset);
+    ReadCompressed(TEXDecode::PVRTC4, header.pvrtcSize, 8);
+  } else if (header.format == TEXFormatAndr::ETC1) {
+    ReadCompressed(TEXDecode::ETC1, rd.GetSize() - sizeof(header), 4);
   } else if (header.format == TEXFormatAndr::RGBA4) {
     main.asDDS = DDSFormat_A4R4G4B4;
     size_t bufferSize = main.asDDS.ComputeBufferSize(main.mips);
-    rd.ReadContainer(main.buffer, bufferSize);
+    main.ReadPixels(rd_, bufferSize);
   } else if (header.format == TEXFormatAndr::RGBA8) {
     main.asDDS = DDSFormat_A8B8G8R8;
     size_t bufferSize = main.asDDS.ComputeBufferSize(main.mips);
-    rd.ReadContainer(main.buffer, bufferSize);
+    main.ReadPixels(rd_, bufferSize);
   } else {
     throw std::runtime_error("Unknown texture format!");
   }
 
-  main.ConvertBuffer(Platform::Android);
+  main.Defer(Platform::Android);
 
   return main;
 }
 
-static const std::map<uint16, TEX (*)(BinReaderRef_e, Platform)> texLoaders{
-    {0x66, LoadTEXx66<TEXx66>}, {0x70, LoadTEXx66<TEXx70>}, {0x87, LoadTEXx87},
-    {0x9D, LoadTEXx9D},         {0x09, LoadTEXx09},
-};
+static const std::map<uint16, TEX (*)(BinReaderRef_e, Platform, bool)>
+    texLoaders{
+        {0x66, LoadTEXx66<TEXx66>}, {0x70, LoadTEXx66<TEXx70>},
+        {0x87, LoadTEXx87},         {0x9D, LoadTEXx9D},
+        {0x09, LoadTEXx09},
+    };
+
+// Returns platform texture was loaded for
+static Platform LoadTEX(TEX &out, BinReaderRef_e rd, Platform platform,
+                        bool headerOnly) {
+  auto &deferred = TEXInternal::Deferred(out);
+  deferred.reset();
 
-void TEX::Load(BinReaderRef_e rd, Platform platform) {
   struct {
     uint32 id;
     union {
@@ -763,8 +984,8 @@ void TEX::Load(BinReaderRef_e rd, Platform platform) {
       throw std::runtime_error("X360 texture format is unsupported.");
     }
 
-    *this = LoadTEXx56(rd);
-    return;
+    out = LoadTEXx56(rd, headerOnly);
+    return Platform::Win32;
   } else if (rd.SwappedEndian()) {
     FByteswapper(header.versionV11);
   }
@@ -773,11 +994,19 @@ void TEX::Load(BinReaderRef_e rd, Platform platform) {
     platform = rd.SwappedEndian() ? Platform::PS3 : Platform::Win32;
   }
 
+  auto Loaded = [&] {
+    if (deferred && deferred->platform != Platform::Auto) {
+      return deferred->platform;
+    }
+
+    return platform;
+  };
+
   auto found = texLoaders.find(header.versionV11);
 
   if (!es::IsEnd(texLoaders, found)) {
-    *this = found->second(rd, platform);
-    return;
+    out = found->second(rd, platform, headerOnly);
+    return Loaded();
   }
 
   if (rd.SwappedEndian()) {
@@ -790,27 +1019,146 @@ void TEX::Load(BinReaderRef_e rd, Platform platform) {
     throw es::InvalidVersionError();
   }
 
-  *this = found->second(rd, platform);
-  return;
+  out = found->second(rd, platform, headerOnly);
+  return Loaded();
 }
 
-void TEX::SaveAsDDS(BinWritterRef wr, Tex2DdsSettings settings) {
-  size_t headerSize = asDDS.dxgiFormat ? DDS::DDS_SIZE : DDS::LEGACY_SIZE;
+void TEX::LoadDeferred(BinReaderRef_e rd, Platform platform) {
+  LoadTEX(*this, rd, platform, false);
+}
+
+Platform TEX::Probe(BinReaderRef_e rd, Platform platform) {
+  const Platform loaded = LoadTEX(*this, rd, platform, true);
+  deferred.reset();
+
+  return loaded;
+}
+
+void TEX::Load(BinReaderRef_e rd, Platform platform) {
+  LoadDeferred(rd, platform);
+
+  for (size_t t = 0, numTasks = NumTasks(); t < numTasks; t++) {
+    RunTask(t);
+  }
+}
+
+size_t TEX::NumTasks() const { return deferred ? deferred->numTasks : 0; }
+
+void TEX::RunTask(size_t index) {
+  TEXDeferred &pending = *deferred;
+  const size_t mip = index % pending.numMips;
+  const size_t offset =
+      index / pending.numMips * pending.sliceSize + mips.offsets[mip];
+  const std::span<char> data(buffer.data() + offset, mips.sizes[mip]);
+  std::span<const char> stored(pending.source);
+
+  if (!pending.sourceOffsets.empty()) {
+    stored = stored.subspan(pending.sourceOffsets[mip]);
+  } else if (pending.decode == TEXDecode::PS3Morton ||
+             (pending.decode == TEXDecode::PS4Tiled && index)) {
+    stored = stored.subspan(offset, data.size());
+  }
+
+  ConvertSurface(pending, index, stored, data, asDDS.width >> mip,
+                 asDDS.height >> mip);
+
+  if (pending.remainingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    deferred.reset();
+  }
+}
+
+// Applies legacy settings, returns size of DDS header to write
+static size_t PrepareDDSHeader(DDS &dds, const Tex2DdsSettings &settings) {
+  size_t headerSize = dds.dxgiFormat ? DDS::DDS_SIZE : DDS::LEGACY_SIZE;
 
   if (settings.convertIntoLegacy) {
-    int result = asDDS.ToLegacy(settings.convertIntoLegacyNonCannon);
+    int result = dds.ToLegacy(settings.convertIntoLegacyNonCannon);
 
     if (!result) {
       headerSize = DDS::LEGACY_SIZE;
     }
   }
 
+  return headerSize;
+}
+
+void TEX::SaveAsDDS(BinWritterRef wr, Tex2DdsSettings settings) {
+  const size_t headerSize = PrepareDDSHeader(asDDS, settings);
+
+  if (!settings.noMips || asDDS.mipMapCount < 2) {
+    wr.WriteBuffer(reinterpret_cast<const char *>(&asDDS), headerSize);
+    wr.WriteContainer(buffer);
+    return;
+  }
+
+  // Largest mip of every face or array slice
+  const size_t lastMip = asDDS.mipMapCount - 1;
+  const size_t sliceSize = mips.offsets[lastMip] + mips.sizes[lastMip];
+  asDDS.NumMipmaps(1);
   wr.WriteBuffer(reinterpret_cast<const char *>(&asDDS), headerSize);
 
+  for (size_t s = 0; s + sliceSize <= buffer.size(); s += sliceSize) {
+    wr.WriteBuffer(buffer.data() + s, mips.sizes[0]);
+  }
+}
+
+// Reads single stored surface of header only load
+static void ReadSurface(BinReaderRef_e rd, const TEXDeferred &pending,
+                        const DDS::Mips &mips, size_t index,
+                        std::string &stored) {
+  const size_t mip = index % pending.numMips;
+  const size_t offset =
+      index / pending.numMips * pending.sliceSize + mips.offsets[mip];
+  uint64 streamOffset = pending.dataOffset + offset;
+  size_t size = mips.sizes[mip];
+
+  if (!pending.sourceOffsets.empty()) {
+    streamOffset = pending.dataOffset + pending.sourceOffsets[mip];
+    size = pending.sourceOffsets[mip + 1] - pending.sourceOffsets[mip];
+  } else if (!pending.surfaceOffsets.empty()) {
+    streamOffset = pending.surfaceOffsets[index];
+  }
+
+  if (pending.decode == TEXDecode::PS4Tiled && index == 0) {
+    // Tiles past the end of stored data are blank
+    stored.assign(std::max(size, PS4TiledSize(pending.tiledWidth,
+                                              pending.tiledHeight,
+                                              pending.blockSize)),
+                  '\0');
+    size = std::min(stored.size(), pending.storedSize);
+  } else {
+    stored.resize(size);
+  }
+
+  rd.Seek(streamOffset);
+  rd.ReadBuffer(stored.data(), size);
+}
+
+void TEX::StreamAsDDS(BinReaderRef_e rd, BinWritterRef wr,
+                      Tex2DdsSettings settings) {
+  LoadTEX(*this, rd, settings.platformOverride, true);
+  const std::shared_ptr<TEXDeferred> pending = std::move(deferred);
+  const size_t headerSize = PrepareDDSHeader(asDDS, settings);
+  const size_t numMips = settings.noMips ? 1 : pending->numMips;
+
   if (settings.noMips && asDDS.mipMapCount > 1) {
     asDDS.NumMipmaps(1);
-    wr.WriteBuffer(buffer.data(), mips.sizes[0]);
-  } else {
-    wr.WriteContainer(buffer);
+  }
+
+  wr.WriteBuffer(reinterpret_cast<const char *>(&asDDS), headerSize);
+
+  // Scratch surfaces are reused, memory is bounded by the largest mip
+  std::string stored;
+  std::string data;
+
+  for (size_t s = 0; s < pending->numSlices; s++) {
+    for (size_t m = 0; m < numMips; m++) {
+      const size_t index = s * pending->numMips + m;
+      ReadSurface(rd, *pending, mips, index, stored);
+      data.resize(mips.sizes[m]);
+      ConvertSurface(*pending, index, stored, data, asDDS.width >> m,
+                     asDDS.height >> m);
+      wr.WriteContainer(data);
+    }
   }
 }
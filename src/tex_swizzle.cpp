@@ -0,0 +1,194 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "tex_swizzle.hpp"
+#include "spike/gpu/addr_ps3.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TEX_SWIZZLE_SSE2
+#endif
+
+/*
+Both layouts interleave x and y bits into disjoint address bits, so address
+of any texel is sum of x and y contributions.
+Contributions are precomputed once per surface, kernels then walk
+destination rows and gather source texels by two table lookups.
+*/
+
+namespace {
+// Block order within 8x8 PS4 micro tile, indexed by [y][x]
+constexpr std::array<std::array<uint8, 8>, 8> MakePS4MicroTile() {
+  std::array<std::array<uint8, 8>, 8> retVal{};
+
+  for (size_t y = 0; y < 8; y++) {
+    for (size_t x = 0; x < 8; x++) {
+      retVal[y][x] = uint8(AddrPS4(x, y, 8));
+    }
+  }
+
+  return retVal;
+}
+
+constexpr auto PS4_MICRO_TILE = MakePS4MicroTile();
+
+uint32 LoadTexel(const char *src) {
+  uint32 retVal;
+  memcpy(&retVal, src, sizeof(retVal));
+  return retVal;
+}
+
+#if defined(TEX_SWIZZLE_SSE2)
+__m128i ByteSwap32(__m128i value) {
+  value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+  value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+}
+#endif
+
+template <size_t BLOCK_SIZE>
+void DeswizzlePS4Blocks(const char *src, char *dst, size_t width,
+                        size_t height, size_t macroWidth) {
+  static constexpr size_t TILE_SIZE = BLOCK_SIZE * 64;
+  const size_t dstPitch = width * BLOCK_SIZE;
+
+  for (size_t ty = 0; ty < height; ty += 8) {
+    const char *tileRow = src + (ty / 8) * macroWidth * TILE_SIZE;
+    const size_t numRows = std::min(height - ty, size_t(8));
+
+    for (size_t tx = 0; tx < width; tx += 8) {
+      const char *tile = tileRow + (tx / 8) * TILE_SIZE;
+      char *dstTile = dst + ty * dstPitch + tx * BLOCK_SIZE;
+
+      if (width - tx >= 8) {
+        for (size_t r = 0; r < numRows; r++) {
+          char *dstRow = dstTile + r * dstPitch;
+
+          for (size_t c = 0; c < 8; c++) {
+            memcpy(dstRow + c * BLOCK_SIZE,
+                   tile + PS4_MICRO_TILE[r][c] * BLOCK_SIZE, BLOCK_SIZE);
+          }
+        }
+      } else {
+        const size_t numColumns = width - tx;
+
+        for (size_t r = 0; r < numRows; r++) {
+          char *dstRow = dstTile + r * dstPitch;
+
+          for (size_t c = 0; c < numColumns; c++) {
+            memcpy(dstRow + c * BLOCK_SIZE,
+                   tile + PS4_MICRO_TILE[r][c] * BLOCK_SIZE, BLOCK_SIZE);
+          }
+        }
+      }
+    }
+  }
+}
+} // namespace
+
+size_t PS4TiledPitch(size_t numBlocks) {
+  return std::bit_ceil(std::max(numBlocks, size_t(8)));
+}
+
+size_t PS4TiledSize(size_t width, size_t height, size_t blockSize) {
+  if (!width || !height) {
+    return 0;
+  }
+
+  const size_t macroWidth = PS4TiledPitch(width) / 8;
+  const size_t lastTile = (height - 1) / 8 * macroWidth + (width - 1) / 8;
+
+  return (lastTile + 1) * 64 * blockSize;
+}
+
+void DeswizzlePS3RGBA8(std::span<const char> src, std::span<char> dst,
+                       uint32 width, uint32 height) {
+  const size_t linearSize = size_t(width) * height * sizeof(uint32);
+
+  if (src.size() < linearSize || dst.size() < linearSize) {
+    throw std::runtime_error("Swizzled texture is truncated.");
+  }
+
+  MortonSettings mset(width, height);
+  std::vector<uint32> tableX(width);
+  std::vector<uint32> tableY(height);
+
+  for (uint32 x = 0; x < width; x++) {
+    tableX[x] = MortonAddr(x, 0, mset) * sizeof(uint32);
+  }
+
+  for (uint32 y = 0; y < height; y++) {
+    tableY[y] = MortonAddr(0, y, mset) * sizeof(uint32);
+  }
+
+  for (uint32 y = 0; y < height; y++) {
+    const char *srcY = src.data() + tableY[y];
+    char *dstRow = dst.data() + size_t(y) * width * sizeof(uint32);
+    uint32 x = 0;
+
+#if defined(TEX_SWIZZLE_SSE2)
+    for (; x + 4 <= width; x += 4) {
+      const __m128i texels = _mm_set_epi32(
+          LoadTexel(srcY + tableX[x + 3]), LoadTexel(srcY + tableX[x + 2]),
+          LoadTexel(srcY + tableX[x + 1]), LoadTexel(srcY + tableX[x]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dstRow + x * 4),
+                       ByteSwap32(texels));
+    }
+#endif
+
+    for (; x < width; x++) {
+      const uint32 texel = std::byteswap(LoadTexel(srcY + tableX[x]));
+      memcpy(dstRow + x * 4, &texel, sizeof(texel));
+    }
+  }
+}
+
+void DeswizzlePS4(std::span<const char> src, std::span<char> dst, size_t width,
+                  size_t height, size_t blockSize) {
+  if (src.size() < PS4TiledSize(width, height, blockSize) ||
+      dst.size() < width * height * blockSize) {
+    throw std::runtime_error("Tiled texture is truncated.");
+  }
+
+  const size_t macroWidth = PS4TiledPitch(width) / 8;
+
+  switch (blockSize) {
+  case 1:
+    return DeswizzlePS4Blocks<1>(src.data(), dst.data(), width, height,
+                                 macroWidth);
+  case 2:
+    return DeswizzlePS4Blocks<2>(src.data(), dst.data(), width, height,
+                                 macroWidth);
+  case 4:
+    return DeswizzlePS4Blocks<4>(src.data(), dst.data(), width, height,
+                                 macroWidth);
+  case 8:
+    return DeswizzlePS4Blocks<8>(src.data(), dst.data(), width, height,
+                                 macroWidth);
+  case 16:
+    return DeswizzlePS4Blocks<16>(src.data(), dst.data(), width, height,
+                                  macroWidth);
+  default:
+    throw std::runtime_error("Unsupported tiled block size.");
+  }
+}
@@ -0,0 +1,62 @@
+/*  Revil Format Library
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "spike/util/supercore.hpp"
+#include <span>
+
+// Reference block address of PS4 tiled surface
+// Blocks are tiled into 8x8 micro tiles of 64 consecutive blocks
+// width is pitch in blocks, must be power of 2 and at least 8
+constexpr size_t AddrPS4(size_t x, size_t y, size_t width) {
+  const size_t x0 = x & 1;
+  const size_t x1 = (x & 2) << 1;
+  const size_t x2 = (x & 4) << 2;
+
+  const size_t y0 = (y & 1) << 1;
+  const size_t y1 = (y & 2) << 2;
+  const size_t y2 = (y & 4) << 3;
+
+  size_t retval = x0 | x1 | x2 | y0 | y1 | y2;
+
+  const size_t macroX = x / 8;
+  const size_t macroY = y / 8;
+  const size_t macroWidth = width / 8;
+
+  const size_t macroAddr = (macroWidth * macroY) + macroX;
+
+  return retval | (macroAddr << 6);
+}
+
+// Rounded up to power of 2, at least one micro tile
+size_t PS4TiledPitch(size_t numBlocks);
+
+// Number of bytes occupied by tiled surface of width x height blocks
+size_t PS4TiledSize(size_t width, size_t height, size_t blockSize);
+
+/*
+Tiled to linear kernels, src and dst must not overlap.
+PS3: swizzled RGBA8 surface with power of 2 dimensions, texels are byte
+swapped into little endian.
+PS4: width and height are in blocks, blockSize is one of 1, 2, 4, 8, 16.
+Both throw when src is smaller than tiled surface or dst is smaller than
+linear surface.
+*/
+void DeswizzlePS3RGBA8(std::span<const char> src, std::span<char> dst,
+                       uint32 width, uint32 height);
+void DeswizzlePS4(std::span<const char> src, std::span<char> dst, size_t width,
+                  size_t height, size_t blockSize);
@@ -0,0 +1,223 @@
+#pragma once
+#include "revil/arc.hpp"
+#include "spike/io/binwritter_stream.hpp"
+#include "spike/util/unit_testing.hpp"
+#include <filesystem>
+#include <fstream>
+
+static std::string MakeTestARC(bool bigEndian,
+                               std::span<const std::string> payloads) {
+  auto Write32 = [&](std::string &out, uint32 value) {
+    if (bigEndian) {
+      value = std::byteswap(value);
+    }
+
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+
+  const uint32 numFiles = payloads.size();
+  std::string retVal;
+  Write32(retVal, 0x435241);
+  Write32(retVal, bigEndian ? (7 << 16) | numFiles : 7 | (numFiles << 16));
+  Write32(retVal, 0);
+
+  std::string data;
+  uint32 offset = 12 + numFiles * 0x50;
+  revil::ARCCodec codec;
+
+  for (size_t i = 0; i < numFiles; i++) {
+    auto &payload = payloads[i];
+    std::string compressed(revil::ARCCodec::DeflateBound(payload.size()), 0);
+    compressed.resize(codec.Deflate(payload, compressed,
+                                    revil::ARCCodec::LEVEL_BEST, 15));
+
+    // PS3 raw entry
+    if (bigEndian && i == 0) {
+      compressed = payload;
+    }
+
+    char fileName[0x40]{};
+    snprintf(fileName, sizeof(fileName), "folder\\file_%zu", i);
+    retVal.append(fileName, sizeof(fileName));
+    Write32(retVal, 0x241F5DEB);
+    Write32(retVal, compressed.size());
+    Write32(retVal, payload.size() | 0x40000000);
+    Write32(retVal, offset + data.size());
+    data.append(compressed);
+  }
+
+  return retVal + data;
+}
+
+static int TestARCArchive(bool bigEndian) {
+  const std::string payloads[]{
+      std::string(1000, 'A'),
+      "Some uncompressible data.",
+      std::string(0x12345, 'x') + std::string(100, 'y'),
+  };
+
+  auto path = std::filesystem::temp_directory_path() /
+              (bigEndian ? "revil_test.cra.arc" : "revil_test.arc");
+
+  {
+    std::ofstream str(path, std::ios::binary);
+    str << MakeTestARC(bigEndian, payloads);
+  }
+
+  revil::ARCArchive archive(path.string());
+  auto &entries = archive.Entries();
+  TEST_EQUAL(entries.size(), 3);
+  TEST_EQUAL(archive.Version(), 7);
+  TEST_EQUAL(archive.GetPlatform() == revil::Platform::PS3, bigEndian);
+  TEST_EQUAL(entries[1].fileName, "folder\\file_1");
+  TEST_EQUAL(entries[1].typeHash, 0x241F5DEB);
+  TEST_EQUAL(archive.Find("folder\\file_2"), 2);
+  TEST_EQUAL(archive.Find("folder\\file_2", 0), 3);
+  TEST_EQUAL(archive.Find("file_2"), 3);
+
+  std::string buffer;
+
+  for (size_t i = 0; i < std::size(payloads); i++) {
+    TEST_EQUAL(entries[i].uncompressedSize, payloads[i].size());
+    buffer.assign(entries[i].uncompressedSize, 0);
+    TEST_EQUAL(archive.Read(i, buffer), payloads[i].size());
+    TEST_EQUAL(buffer, payloads[i]);
+  }
+
+  buffer.assign(payloads[2].size(), 0);
+  archive.Read("folder\\file_2", buffer);
+  TEST_EQUAL(buffer, payloads[2]);
+
+  std::filesystem::remove(path);
+
+  return 0;
+}
+
+int test_arc00() { return TestARCArchive(false); }
+
+int test_arc01() { return TestARCArchive(true); }
+
+int test_arc02() {
+  const std::string payloads[]{"data0", "data1", "data2", "data3"};
+  auto path = std::filesystem::temp_directory_path() / "revil_test_index.arc";
+  auto indexPath = path.string() + ".idx";
+
+  {
+    std::ofstream str(path, std::ios::binary);
+    str << MakeTestARC(false, payloads);
+  }
+
+  std::filesystem::remove(indexPath);
+
+  {
+    revil::ARCArchive archive(path.string());
+    TEST_EQUAL(archive.LoadIndex(indexPath), false);
+    TEST_EQUAL(archive.Find("FOLDER/File_3"), 3);
+    TEST_EQUAL(archive.Find("folder\\file_3", 0x241F5DEB), 3);
+    TEST_EQUAL(archive.Find("folder\\file_3", 0), 4);
+    TEST_EQUAL(archive.Find("folder\\file_4"), 4);
+    TEST_EQUAL(archive.FindPath("folder\\file_1.tex"), 1);
+    TEST_EQUAL(archive.FindPath("folder\\file_1.mod"), 4);
+    TEST_EQUAL(archive.FindPath("folder\\file_1"), 4);
+    archive.SaveIndex(indexPath);
+  }
+
+  {
+    revil::ARCArchive archive(path.string());
+    TEST_EQUAL(archive.LoadIndex(indexPath), true);
+
+    for (size_t i = 0; i < std::size(payloads); i++) {
+      TEST_EQUAL(archive.Find(archive.Entries()[i].fileName), i);
+    }
+
+    // Index is in use already
+    TEST_EQUAL(archive.LoadIndex(indexPath), false);
+  }
+
+  {
+    // Every slot taken, probing would never stop
+    std::fstream str(indexPath,
+                     std::ios::binary | std::ios::in | std::ios::out);
+    std::string sidecar((std::istreambuf_iterator<char>(str)),
+                        std::istreambuf_iterator<char>());
+    const size_t headerSize = 32;
+
+    for (size_t s = headerSize + 4; s < sidecar.size(); s += 8) {
+      memset(sidecar.data() + s, 0, 4);
+    }
+
+    str.seekp(0);
+    str.write(sidecar.data(), sidecar.size());
+  }
+
+  {
+    revil::ARCArchive archive(path.string());
+    TEST_EQUAL(archive.LoadIndex(indexPath), false);
+    TEST_EQUAL(archive.Find("folder\\file_3"), 3);
+  }
+
+  std::filesystem::remove(indexPath);
+  std::filesystem::remove(path);
+
+  return 0;
+}
+
+static int TestARCWriter(revil::Platform platform) {
+  const std::string payloads[]{
+      std::string(0x20000, 'z'),
+      "Stored data",
+      std::string(777, 'q') + "end",
+  };
+  const std::string_view names[]{"dir/entry0", "dir/entry1", "entry2"};
+
+  revil::ArcSupport support;
+  support.version = 7;
+  std::vector<revil::ARCWriteEntry> entries;
+  std::string data;
+  revil::ARCCodec codec;
+
+  for (size_t i = 0; i < std::size(payloads); i++) {
+    std::string compressed(revil::ARCCodec::DeflateBound(payloads[i].size()),
+                           0);
+    compressed.resize(codec.Deflate(payloads[i], compressed,
+                                    revil::ARCCodec::LEVEL_BEST,
+                                    support.windowSize));
+    entries.push_back({names[i], 0x241F5DEB, uint32(compressed.size()),
+                       uint32(payloads[i].size())});
+    data.append(compressed);
+  }
+
+  auto path = std::filesystem::temp_directory_path() / "revil_test_writer.arc";
+
+  {
+    std::ofstream str(path, std::ios::binary);
+    const size_t dataOffset = revil::WriteARCHeader(BinWritterRef_e(str),
+                                                    entries, support, platform);
+    TEST_EQUAL(size_t(str.tellp()), dataOffset);
+    str << data;
+  }
+
+  revil::ARCArchive archive(path.string(), {}, platform);
+  TEST_EQUAL(archive.Entries().size(), std::size(payloads));
+  std::string buffer;
+
+  for (size_t i = 0; i < std::size(payloads); i++) {
+    const size_t index = archive.Find(names[i], 0x241F5DEB);
+    TEST_EQUAL(index, i);
+    buffer.assign(payloads[i].size(), 0);
+    archive.Read(index, buffer);
+    TEST_EQUAL(buffer, payloads[i]);
+  }
+
+  if (platform == revil::Platform::Win32) {
+    TEST_EQUAL(archive.Entries()[0].fileName, "dir\\entry0");
+  }
+
+  std::filesystem::remove(path);
+
+  return 0;
+}
+
+int test_arc03() { return TestARCWriter(revil::Platform::Win32); }
+
+int test_arc04() { return TestARCWriter(revil::Platform::PS3); }
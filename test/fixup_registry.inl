@@ -0,0 +1,25 @@
+#pragma once
+#include "fixup_registry.hpp"
+#include "spike/util/unit_testing.hpp"
+
+int test_fixup_registry00() {
+  revil::FixupRegistry fixups;
+  std::vector<uint64> slots(5000);
+
+  for (auto &s : slots) {
+    TEST_EQUAL(fixups.Insert(&s), true);
+  }
+
+  TEST_EQUAL(fixups.Size(), slots.size());
+
+  for (auto &s : slots) {
+    TEST_EQUAL(fixups.Contains(&s), true);
+    TEST_EQUAL(fixups.Insert(&s), false);
+  }
+
+  uint64 other;
+  TEST_EQUAL(fixups.Contains(&other), false);
+  TEST_EQUAL(fixups.Size(), slots.size());
+
+  return 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "revil/hashreg.hpp"
+#include "spike/util/unit_testing.hpp"
+
+int test_hashreg00() {
+  using revil::Platform;
+  const uint32 hashes[]{
+      revil::MTHashV1("rTexture"),     revil::MTHashV1("rModel"),
+      revil::MTHashV1("rMotionList"),  revil::MTHashV2("rSoundReverb"),
+      revil::MTHashV2("rLayout"),      revil::MTHashV2("rSoundSourceADPCM"),
+      revil::MTHashV1("rSoundReverb"), 0x241F5DEB,
+      0x7FFFFFFF,                      0,
+  };
+
+  const std::pair<std::string_view, Platform> resolvers[]{
+      {{}, Platform::Auto},     {{}, Platform::PS3},
+      {"re6", Platform::Win32}, {"mh4", Platform::N3DS},
+      {"mhs", Platform::IOS},   {"dd", Platform::PS3},
+  };
+
+  for (auto [title, platform] : resolvers) {
+    revil::ExtensionResolver resolver(title, platform);
+
+    for (uint32 hash : hashes) {
+      TEST_EQUAL(resolver(hash), revil::GetExtension(hash, title, platform));
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,478 @@
+#pragma once
+#include "mtf_lmt/codecs.hpp"
+#include "pugixml.hpp"
+#include "revil/lmt.hpp"
+#include "spike/io/binreader_stream.hpp"
+#include "spike/util/unit_testing.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+// Generated from resources_lmt templates
+static const char *const testLMTFixtures[]{
+    LMT_RESOURCES "pose51.xml",
+    LMT_RESOURCES "pose56.xml",
+};
+
+struct TestLMTFile {
+  std::string data;
+  // Expected for every slot, empty slots included
+  std::vector<revil::LMTBlockInfo> blocks;
+};
+
+// Beginning of x86 animation, event groups follow
+struct TestLMTAnimation {
+  uint32 tracks;
+  uint32 numTracks;
+  uint32 numFrames;
+  int32 loopFrame;
+  float endFrameAdditiveScenePosition[4];
+  float endFrameAdditiveSceneRotation[4];
+};
+
+struct TestLMTEventGroup {
+  uint16 eventRemaps[32];
+  uint32 numEvents;
+  uint32 events;
+};
+
+// x86 bone track, extremes are stored since LMT 56
+struct TestLMTTrack {
+  uint8 compression;
+  uint8 trackType;
+  uint8 boneType;
+  uint8 boneID;
+  float weight;
+  uint32 bufferSize;
+  uint32 buffer;
+  float referenceData[4];
+  uint32 extremes;
+};
+
+template <class C>
+static void AppendTestKeys(std::string &out, std::string_view text,
+                           size_t numKeys, bool bigEndian) {
+  for (size_t k = 0; k < numKeys; k++) {
+    C key{};
+    text = key.RetreiveFromString(text);
+    const size_t size = key.Size();
+
+    if (bigEndian) {
+      key.SwapEndian();
+    }
+
+    out.append(reinterpret_cast<const char *>(&key), size);
+  }
+}
+
+struct TestLMTCodec {
+  uint8 compression[2]; // LMT 51, LMT 56
+  void (*appendKeys)(std::string &, std::string_view, size_t, bool);
+};
+
+static const std::map<std::string_view, TestLMTCodec> testLMTCodecs{
+    {"HermiteVector3", {{5, 0}, AppendTestKeys<Buf_HermiteVector3>}},
+    {"LinearVector3", {{9, 3}, AppendTestKeys<Buf_LinearVector3>}},
+    {"LinearRotationQuat4_14bit",
+     {{6, 6}, AppendTestKeys<Buf_LinearRotationQuat4_14bit>}},
+    {"BiLinearVector3_16bit",
+     {{0, 4}, AppendTestKeys<Buf_BiLinearVector3_16bit>}},
+    {"BiLinearRotationQuat4_7bit",
+     {{0, 7}, AppendTestKeys<Buf_BiLinearRotationQuat4_7bit>}},
+};
+
+// Same order as LMTTrack::TrackType_e
+static const std::string_view testLMTTrackTypes[]{
+    "TrackType_LocalRotation",    "TrackType_LocalPosition",
+    "TrackType_LocalScale",       "TrackType_AbsoluteRotation",
+    "TrackType_AbsolutePosition",
+};
+
+static std::array<float, 4> ReadTestVector(std::string_view text) {
+  std::array<float, 4> retVal{};
+
+  for (float &v : retVal) {
+    text.remove_prefix(
+        std::min(text.find_first_of("-0123456789"), text.size()));
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), v);
+    text.remove_prefix(ptr - text.data());
+  }
+
+  return retVal;
+}
+
+// Writes x86 LMT described by resources_lmt XML, animation IDs are slots
+static TestLMTFile MakeTestLMT(const char *fixture, bool bigEndian) {
+  pugi::xml_document doc;
+
+  if (!doc.load_file(fixture)) {
+    throw std::runtime_error(std::string("Cannot load ") + fixture);
+  }
+
+  TestLMTFile retVal;
+  std::string &data = retVal.data;
+  auto Encode = [&](auto value) {
+    auto raw = std::bit_cast<std::array<char, sizeof(value)>>(value);
+
+    if (bigEndian) {
+      std::ranges::reverse(raw);
+    }
+
+    return raw;
+  };
+  auto Write = [&](auto value) {
+    const auto raw = Encode(value);
+    data.append(raw.data(), raw.size());
+  };
+  auto WriteVector = [&](pugi::xml_node node) {
+    for (float v : ReadTestVector(node.text().get())) {
+      Write(v);
+    }
+  };
+  auto Patch = [&](size_t offset, uint32 value) {
+    const auto raw = Encode(value);
+    memcpy(data.data() + offset, raw.data(), raw.size());
+  };
+  auto Pad = [&] { data.append(GetPadding(data.size(), 16), '\0'); };
+
+  pugi::xml_node lmtNode = doc.child("LMT");
+  const uint16 version = lmtNode.attribute("version").as_uint();
+  const bool storesExtremes = version >= 56;
+  const size_t numEventGroups = storesExtremes ? 4 : 2;
+  const size_t trackSize = storesExtremes ? sizeof(TestLMTTrack)
+                                          : offsetof(TestLMTTrack, extremes);
+
+  for (pugi::xml_node animNode : lmtNode.children("Animation")) {
+    retVal.blocks.resize(std::max<size_t>(
+        retVal.blocks.size(), animNode.attribute("ID").as_uint() + 1));
+  }
+
+  data.append(bigEndian ? "\0TML" : "LMT\0", 4);
+  Write(version);
+  Write(uint16(retVal.blocks.size()));
+  const size_t offsetsBegin = data.size();
+  data.append(retVal.blocks.size() * sizeof(uint32), '\0');
+  Pad();
+
+  for (pugi::xml_node animNode : lmtNode.children("Animation")) {
+    const uint32 slot = animNode.attribute("ID").as_uint();
+    revil::LMTBlockInfo &block = retVal.blocks[slot];
+    std::vector<pugi::xml_node> tracks;
+
+    for (pugi::xml_node trackNode :
+         animNode.child("tracks").children("track")) {
+      tracks.push_back(trackNode);
+    }
+
+    block.offset = data.size();
+    block.numTracks = tracks.size();
+    block.numFrames = animNode.child("numFrames").text().as_uint();
+    block.loopFrame = animNode.child("loopFrame").text().as_int();
+    Patch(offsetsBegin + slot * sizeof(uint32), block.offset);
+
+    const size_t tracksBegin = block.offset + sizeof(TestLMTAnimation) +
+                               numEventGroups * sizeof(TestLMTEventGroup);
+    Write(uint32(tracksBegin));
+    Write(block.numTracks);
+    Write(block.numFrames);
+    Write(block.loopFrame);
+    WriteVector(animNode.child("endFrameAdditiveScenePosition"));
+    WriteVector(animNode.child("endFrameAdditiveSceneRotation"));
+    data.append(numEventGroups * sizeof(TestLMTEventGroup), '\0');
+
+    for (pugi::xml_node trackNode : tracks) {
+      const auto &codec =
+          testLMTCodecs.at(trackNode.child("compression").text().get());
+      const std::string_view trackType =
+          trackNode.child("trackType").text().get();
+      Write(codec.compression[storesExtremes]);
+      Write(uint8(
+          std::distance(std::begin(testLMTTrackTypes),
+                        std::ranges::find(testLMTTrackTypes, trackType))));
+      Write(uint8(trackNode.child("boneType").text().as_uint()));
+      Write(uint8(trackNode.child("boneID").text().as_uint()));
+      Write(trackNode.child("weight").text().as_float());
+      Write(uint32(0)); // bufferSize
+      Write(uint32(0)); // buffer
+      WriteVector(trackNode.child("referenceData"));
+
+      if (storesExtremes) {
+        Write(uint32(0));
+      }
+    }
+
+    for (size_t t = 0; t < tracks.size(); t++) {
+      const size_t trackOffset = tracksBegin + t * trackSize;
+
+      if (pugi::xml_node minNode = tracks[t].child("min"); minNode) {
+        Pad();
+        Patch(trackOffset + offsetof(TestLMTTrack, extremes), data.size());
+        WriteVector(minNode);
+        WriteVector(tracks[t].child("max"));
+      }
+
+      Pad();
+      const size_t bufferBegin = data.size();
+      pugi::xml_node dataNode = tracks[t].child("data");
+      testLMTCodecs.at(tracks[t].child("compression").text().get())
+          .appendKeys(data, dataNode.text().get(),
+                      dataNode.attribute("numItems").as_uint(), bigEndian);
+      Patch(trackOffset + offsetof(TestLMTTrack, bufferSize),
+            data.size() - bufferBegin);
+      Patch(trackOffset + offsetof(TestLMTTrack, buffer), bufferBegin);
+    }
+  }
+
+  // Variable size keys are copied whole
+  data.append(sizeof(Buf_HermiteVector3), '\0');
+
+  return retVal;
+}
+
+static const Vector4A16 &PoseChannel(const revil::LMTPose &pose,
+                                     const revil::LMTTrack &track,
+                                     size_t bone) {
+  switch (track.GetTrackType()) {
+  case revil::LMTTrack::TrackType_LocalRotation:
+  case revil::LMTTrack::TrackType_AbsoluteRotation:
+    return pose.rotations[bone];
+  case revil::LMTTrack::TrackType_LocalPosition:
+  case revil::LMTTrack::TrackType_AbsolutePosition:
+    return pose.translations[bone];
+  default:
+    return pose.scales[bone];
+  }
+}
+
+int test_lmt00() {
+  Vector4A16::SetEpsilon(0.0001f);
+
+  for (const char *fixture : testLMTFixtures) {
+    std::stringstream str(MakeTestLMT(fixture, false).data);
+    revil::LMT lmt;
+    lmt.Load(BinReaderRef_e(str));
+
+    for (size_t a = 0; a < lmt.NumBlocks(); a++) {
+      const revil::LMTAnimation *anim = lmt.Animation(a);
+
+      if (!anim) {
+        continue;
+      }
+
+      revil::LMTPoseEvaluator evaluator(*anim);
+      const auto bones = evaluator.Bones();
+      TEST_EQUAL(bones.size(), 2);
+
+      // Past duration samples hold last keys
+      std::vector<float> times;
+
+      for (size_t i = 0; i / 140.f < evaluator.Duration() + 0.1f; i++) {
+        times.push_back(i / 140.f);
+      }
+
+      std::vector<revil::LMTPose> poses(times.size());
+      evaluator.Evaluate(poses, times);
+      revil::LMTPose pose;
+
+      for (auto t : *anim->Tracks()) {
+        auto track = static_cast<const revil::LMTTrack *>(t.get());
+        const size_t bone = std::distance(
+            bones.begin(), std::ranges::find(bones, track->BoneIndex(),
+                                             &revil::LMTPoseBone::index));
+        TEST_EQUAL(bone < bones.size(), true);
+        TEST_EQUAL((bones[bone].trackTypes >> track->GetTrackType()) & 1, 1);
+
+        for (size_t i = 0; i < times.size(); i++) {
+          Vector4A16 expected;
+          track->GetValue(expected, times[i]);
+          TEST_EQUAL(PoseChannel(poses[i], *track, bone), expected);
+          evaluator.Evaluate(pose, times[i]);
+          TEST_EQUAL(PoseChannel(pose, *track, bone), expected);
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+static int TestLMTMapped(const char *fixture, bool bigEndian) {
+  const std::string source = MakeTestLMT(fixture, bigEndian).data;
+  auto path = std::filesystem::temp_directory_path() /
+              (bigEndian ? "revil_test_be.lmt" : "revil_test.lmt");
+
+  {
+    std::ofstream str(path, std::ios::binary);
+    str << source;
+  }
+
+  {
+    std::stringstream str(source);
+    revil::LMT loaded;
+    loaded.Load(BinReaderRef_e(str));
+    revil::LMT mapped;
+    mapped.LoadMapped(path.string());
+
+    TEST_EQUAL(mapped.NumBlocks(), loaded.NumBlocks());
+    TEST_EQUAL(mapped.Version() == loaded.Version(), true);
+    TEST_EQUAL(mapped.Architecture() == revil::LMTArchType::X86, true);
+    Vector4A16::SetEpsilon(0.00001f);
+    std::vector<float> times;
+
+    for (size_t i = 0; i < 40; i++) {
+      times.push_back(i / 60.f);
+    }
+
+    std::vector<Vector4A16> loadedValues(times.size());
+    std::vector<Vector4A16> mappedValues(times.size());
+
+    for (size_t a = 0; a < loaded.NumBlocks(); a++) {
+      const revil::LMTAnimation *loadedAnim = loaded.Animation(a);
+      const revil::LMTAnimation *mappedAnim = mapped.Animation(a);
+      TEST_EQUAL(mappedAnim == nullptr, loadedAnim == nullptr);
+
+      if (!loadedAnim) {
+        continue;
+      }
+
+      TEST_EQUAL(mappedAnim->NumFrames(), loadedAnim->NumFrames());
+      TEST_EQUAL(mappedAnim->LoopFrame(), loadedAnim->LoopFrame());
+      auto loadedTracks = loadedAnim->Tracks();
+      auto mappedTracks = mappedAnim->Tracks();
+      TEST_EQUAL(mappedTracks->Size(), loadedTracks->Size());
+
+      for (size_t t = 0; t < loadedTracks->Size(); t++) {
+        auto loadedTrack =
+            static_cast<const revil::LMTTrack *>(loadedTracks->At(t).get());
+        auto mappedTrack =
+            static_cast<const revil::LMTTrack *>(mappedTracks->At(t).get());
+        TEST_EQUAL(mappedTrack->BoneIndex(), loadedTrack->BoneIndex());
+        TEST_EQUAL(mappedTrack->GetTrackType(), loadedTrack->GetTrackType());
+        TEST_EQUAL(mappedTrack->CompressionType(),
+                   loadedTrack->CompressionType());
+        TEST_EQUAL(mappedTrack->NumFrames(), loadedTrack->NumFrames());
+
+        for (size_t k = 0; k < loadedTrack->NumFrames(); k++) {
+          TEST_EQUAL(mappedTrack->GetFrame(k), loadedTrack->GetFrame(k));
+        }
+
+        loadedTrack->GetValues(loadedValues, times);
+        mappedTrack->GetValues(mappedValues, times);
+
+        for (size_t i = 0; i < times.size(); i++) {
+          TEST_EQUAL(mappedValues[i], loadedValues[i]);
+        }
+      }
+    }
+
+    // Fixups and key swaps stay in copy on write pages
+    std::ifstream storedStr(path, std::ios::binary);
+    const std::string stored((std::istreambuf_iterator<char>(storedStr)),
+                             std::istreambuf_iterator<char>());
+    TEST_EQUAL(stored == source, true);
+  }
+
+  std::filesystem::remove(path);
+
+  return 0;
+}
+
+static int TestLMTMapped(bool bigEndian) {
+  for (const char *fixture : testLMTFixtures) {
+    if (int retVal = TestLMTMapped(fixture, bigEndian); retVal) {
+      return retVal;
+    }
+  }
+
+  return 0;
+}
+
+int test_lmt01() { return TestLMTMapped(false); }
+
+int test_lmt02() { return TestLMTMapped(true); }
+
+static int TestLMTBlocks(const char *fixture, bool bigEndian) {
+  const TestLMTFile file = MakeTestLMT(fixture, bigEndian);
+  std::stringstream str(file.data);
+  revil::LMT lmt;
+  lmt.Load(BinReaderRef_e(str));
+  TEST_EQUAL(lmt.NumBlocks(), file.blocks.size());
+
+  // Header reads, nothing is constructed yet
+  for (size_t a = 0; a < lmt.NumBlocks(); a++) {
+    const revil::LMTBlockInfo info = lmt.BlockInfo(a);
+    TEST_EQUAL(info.offset, file.blocks[a].offset);
+    TEST_EQUAL(info.numTracks, file.blocks[a].numTracks);
+    TEST_EQUAL(info.numFrames, file.blocks[a].numFrames);
+    TEST_EQUAL(info.loopFrame, file.blocks[a].loopFrame);
+  }
+
+  for (size_t a = 0; a < lmt.NumBlocks(); a++) {
+    const revil::LMTAnimation *anim = lmt.Animation(a);
+    const revil::LMTBlockInfo info = lmt.BlockInfo(a);
+    TEST_EQUAL(anim == nullptr, file.blocks[a].offset == 0);
+    TEST_EQUAL(info.offset, file.blocks[a].offset);
+    TEST_EQUAL(info.numTracks, file.blocks[a].numTracks);
+    TEST_EQUAL(info.numFrames, file.blocks[a].numFrames);
+    TEST_EQUAL(info.loopFrame, file.blocks[a].loopFrame);
+
+    if (anim) {
+      TEST_EQUAL(anim->Tracks()->Size(), info.numTracks);
+      TEST_EQUAL(anim->NumFrames(), info.numFrames);
+      TEST_EQUAL(anim->LoopFrame(), info.loopFrame);
+    }
+  }
+
+  uni::MotionsConst motions = lmt;
+  TEST_EQUAL(motions->Size(), lmt.NumBlocks());
+  size_t index = 0;
+
+  for (auto m : *motions) {
+    TEST_EQUAL(m.get() == lmt.Animation(index++), true);
+  }
+
+  TEST_EQUAL(index, lmt.NumBlocks());
+
+  // Iteration constructs the same objects
+  str.clear();
+  str.seekg(0);
+  revil::LMT iterated;
+  iterated.Load(BinReaderRef_e(str));
+  uni::MotionsConst iteratedMotions = iterated;
+  std::vector<const uni::Motion *> visited;
+
+  for (auto m : *iteratedMotions) {
+    visited.push_back(m.get());
+  }
+
+  TEST_EQUAL(visited.size(), iterated.NumBlocks());
+
+  for (size_t a = 0; a < visited.size(); a++) {
+    TEST_EQUAL(visited[a] == iterated.Animation(a), true);
+    TEST_EQUAL(visited[a] == nullptr, file.blocks[a].offset == 0);
+  }
+
+  return 0;
+}
+
+static int TestLMTBlocks(bool bigEndian) {
+  for (const char *fixture : testLMTFixtures) {
+    if (int retVal = TestLMTBlocks(fixture, bigEndian); retVal) {
+      return retVal;
+    }
+  }
+
+  return 0;
+}
+
+int test_lmt03() { return TestLMTBlocks(false); }
+
+int test_lmt04() { return TestLMTBlocks(true); }
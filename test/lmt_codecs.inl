@@ -1,6 +1,8 @@
 #pragma once
 #include "spike/util/unit_testing.hpp"
 #include "mtf_lmt/codecs.hpp"
+#include "test_random.hpp"
+#include <cstring>
 
 // 90 -180 45
 static const Vector4A16 testingQuat(0.2706f, -0.2706f, -0.65328f, 0.65328f);
@@ -194,3 +196,96 @@ int test_lmt_codec12() {
 
   return 0;
 }
+
+// Bulk decoders must match Evaluate bit by bit, key count covers tail path
+template <class C> int TestBulkDecode() {
+  static constexpr size_t numKeys = 1037;
+  // Evaluate of packed codecs reads whole uint64
+  std::vector<char> raw(numKeys * sizeof(C) + sizeof(uint64));
+  TestRandom{0x5EED}.Fill(raw);
+
+  std::span<const C> keys(reinterpret_cast<const C *>(raw.data()), numKeys);
+  std::vector<float> bulk(numKeys * 4);
+  std::vector<float> scalar(numKeys * 4);
+  auto SoA = [](std::vector<float> &items) {
+    float *data = items.data();
+    return LMTKeysSoA{data, data + numKeys, data + numKeys * 2,
+                      data + numKeys * 3};
+  };
+
+  DecodeKeys(keys, SoA(bulk));
+  DecodeKeysScalar(keys, SoA(scalar));
+
+  TEST_EQUAL(memcmp(bulk.data(), scalar.data(), bulk.size() * sizeof(float)),
+             0);
+
+  return 0;
+}
+
+int test_lmt_codec13() {
+  TEST_EQUAL(TestBulkDecode<Buf_LinearRotationQuat4_14bit>(), 0);
+  TEST_EQUAL(TestBulkDecode<Buf_BiLinearRotationQuat4_7bit>(), 0);
+  TEST_EQUAL(TestBulkDecode<Buf_BiLinearRotationQuat4_11bit>(), 0);
+  TEST_EQUAL(TestBulkDecode<Buf_BiLinearRotationQuat4_9bit>(), 0);
+
+  return 0;
+}
+
+template <class C> int TestTextRoundTrip(TrackTypesShared type) {
+  static constexpr size_t numKeys = 64;
+  std::vector<char> raw(numKeys * sizeof(C));
+  TestRandom{0x7E47}.Fill(raw);
+
+  CTR source(LMTTrackController::CreateCodec(type));
+  source->Assign(raw.data(), raw.size(), false);
+  std::string text;
+  source->ToString(text, 3);
+
+  // Every key must be restored from text
+  CTR target(LMTTrackController::CreateCodec(type));
+  std::vector<char> zeroes(raw.size());
+  target->Assign(zeroes.data(), zeroes.size(), false);
+  target->FromString(text);
+  std::string textBack;
+  target->ToString(textBack, 3);
+
+  TEST_EQUAL(text, textBack);
+  TEST_EQUAL(memcmp(raw.data(), zeroes.data(), raw.size()), 0);
+
+  return 0;
+}
+
+int test_lmt_codec14() {
+  TEST_EQUAL(TestTextRoundTrip<Buf_SphericalRotation>(
+                 TrackTypesShared::SphericalRotation),
+             0);
+  TEST_EQUAL(TestTextRoundTrip<Buf_BiLinearRotationQuat4_9bit>(
+                 TrackTypesShared::BiLinearRotationQuat4_9bit),
+             0);
+
+  std::vector<Buf_LinearVector3> keys(4);
+
+  for (size_t k = 0; k < keys.size(); k++) {
+    keys[k].data = Vector(0.1f * k, -1.0f / (k + 3), 1e-20f * k);
+    keys[k].additiveFrames = k * 7;
+  }
+
+  CTR control(LMTTrackController::CreateCodec(TrackTypesShared::LinearVector3));
+  control->Assign(reinterpret_cast<char *>(keys.data()),
+                  keys.size() * sizeof(Buf_LinearVector3), false);
+  std::string text;
+  control->ToString(text, 2);
+  TEST_EQUAL(text.substr(0, 32), "\n\t\t{ [0, -0.33333334, 0], 0 }\n\t\t");
+  TEST_EQUAL(text.substr(32, 29), "{ [0.1, -0.25, 1e-20], 7 }\n\t\t");
+
+  std::vector<Buf_LinearVector3> keysBack(keys.size());
+  control->Assign(reinterpret_cast<char *>(keysBack.data()),
+                  keysBack.size() * sizeof(Buf_LinearVector3), false);
+  control->FromString(text);
+
+  for (size_t k = 0; k < keys.size(); k++) {
+    TEST_EQUAL(memcmp(&keys[k], &keysBack[k], sizeof(Buf_LinearVector3)), 0);
+  }
+
+  return 0;
+}
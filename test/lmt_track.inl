@@ -0,0 +1,145 @@
+#pragma once
+#include "mtf_lmt/bone_track.hpp"
+#include "mtf_lmt/codecs.hpp"
+#include "spike/util/unit_testing.hpp"
+#include "test_random.hpp"
+#include <algorithm>
+
+static size_t FindKeyReference(std::span<const int16> frames, int32 frame) {
+  for (size_t f = 1; f < frames.size(); f++) {
+    if (frames[f] > frame) {
+      return f;
+    }
+  }
+
+  return frames.size();
+}
+
+int test_lmt_track00() {
+  std::vector<int16> frames{0};
+  TestRandom rng{0x1234};
+
+  for (size_t i = 0; i < 200; i++) {
+    frames.push_back(frames.back() + 1 + (rng.Next() >> 16) % 7);
+  }
+
+  const int32 maxFrame = frames.back();
+  LMTTrackCursor cursor;
+
+  // Sequential sampling
+  for (int32 f = 0; f < maxFrame; f++) {
+    TEST_EQUAL(FindKey(frames, f, cursor), FindKeyReference(frames, f));
+  }
+
+  // Backward sampling
+  for (int32 f = maxFrame - 1; f >= 0; f--) {
+    TEST_EQUAL(FindKey(frames, f, cursor), FindKeyReference(frames, f));
+  }
+
+  // Seeks
+  for (size_t i = 0; i < 1000; i++) {
+    const int32 f = (rng.Next() >> 8) % maxFrame;
+    TEST_EQUAL(FindKey(frames, f, cursor), FindKeyReference(frames, f));
+  }
+
+  // Stale cursor
+  cursor.frame = 100000;
+  TEST_EQUAL(FindKey(frames, 5, cursor), FindKeyReference(frames, 5));
+
+  return 0;
+}
+
+int test_lmt_track01() {
+  std::vector<Buf_LinearVector3> keys(16);
+  std::vector<int16> frames;
+  int16 currentFrame = 0;
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    keys[i].data = Vector(float(i), float(i * 2), float(i * 3));
+    keys[i].additiveFrames = 1 + i % 3;
+    frames.push_back(currentFrame);
+    currentFrame += keys[i].additiveFrames;
+  }
+
+  std::unique_ptr<LMTTrackController> control(
+      LMTTrackController::CreateCodec(TrackTypesShared::LinearVector3));
+  control->Assign(reinterpret_cast<char *>(keys.data()),
+                  keys.size() * sizeof(Buf_LinearVector3), false);
+
+  const float frameRate = 60.f;
+  std::vector<float> times;
+
+  for (size_t i = 0; i < 200; i++) {
+    times.push_back(i / 120.f);
+  }
+
+  // Seek backwards
+  times.push_back(0.05f);
+
+  TrackMinMax bounds;
+  const Vector4A16 lastValue(-1.f, -1.f, -1.f, -1.f);
+  std::vector<Vector4A16> values(times.size());
+  control->Sample(values, times, frameRate, 0, bounds, lastValue);
+
+  Vector4A16::SetEpsilon(0.00001f);
+
+  for (size_t i = 0; i < times.size(); i++) {
+    const float frameDelta = times[i] * frameRate;
+    const int32 frame = static_cast<int32>(frameDelta);
+
+    if (frame >= frames.back()) {
+      TEST_EQUAL(values[i], lastValue);
+      continue;
+    }
+
+    // Key n holds (n, 2n, 3n), linear blend between keys stays on that line
+    const size_t f = FindKeyReference(frames, frame);
+    const float prevFrame = frames[f - 1];
+    const float delta = (frameDelta - prevFrame) / (frames[f] - prevFrame);
+    const float key = float(f - 1) + delta;
+    TEST_EQUAL(values[i], Vector4A16(key, key * 2.f, key * 3.f, 1.f));
+  }
+
+  return 0;
+}
+
+int test_lmt_track02() {
+  std::vector<Buf_LinearVector3> keys(8);
+  std::vector<int16> frames;
+  int16 currentFrame = 0;
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    keys[i].data = Vector(float(i), float(i * 2), float(i * 3));
+    keys[i].additiveFrames = 1 + i % 3;
+    frames.push_back(currentFrame);
+    currentFrame += keys[i].additiveFrames;
+  }
+
+  std::vector<Buf_LinearVector3> bigKeys(keys);
+
+  for (auto &k : bigKeys) {
+    k.SwapEndian();
+  }
+
+  const std::vector<Buf_LinearVector3> bigKeysCopy(bigKeys);
+  const size_t bufferSize = bigKeys.size() * sizeof(Buf_LinearVector3);
+
+  std::unique_ptr<LMTTrackController> control(
+      LMTTrackController::CreateCodec(TrackTypesShared::LinearVector3));
+  control->Assign(reinterpret_cast<char *>(bigKeys.data()), bufferSize, true);
+
+  // Keys are swapped on first access only
+  TEST_EQUAL(memcmp(bigKeys.data(), bigKeysCopy.data(), bufferSize), 0);
+  TEST_EQUAL(control->NumFrames(), keys.size());
+
+  auto ctrFrames = control->Frames();
+  TEST_EQUAL(ctrFrames.size(), frames.size());
+  TEST_EQUAL(std::ranges::equal(ctrFrames, frames), true);
+  TEST_EQUAL(memcmp(bigKeys.data(), keys.data(), bufferSize), 0);
+
+  Vector4A16 value;
+  control->Evaluate(value, 5);
+  TEST_EQUAL(value, Vector4A16(5.f, 10.f, 15.f, 1.f));
+
+  return 0;
+}
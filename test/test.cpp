@@ -1,5 +1,12 @@
 
+#include "arc.inl"
+#include "fixup_registry.inl"
+#include "hashreg.inl"
+#include "lmt.inl"
 #include "lmt_codecs.inl"
+#include "lmt_track.inl"
+#include "tex.inl"
+#include "tex_swizzle.inl"
 
 int main() {
   es::print::AddPrinterFunction(es::Print);
@@ -10,7 +17,19 @@ int main() {
              TEST_FUNC(test_lmt_codec05), TEST_FUNC(test_lmt_codec06),
              TEST_FUNC(test_lmt_codec07), TEST_FUNC(test_lmt_codec08),
              TEST_FUNC(test_lmt_codec09), TEST_FUNC(test_lmt_codec10),
-             TEST_FUNC(test_lmt_codec11), TEST_FUNC(test_lmt_codec12));
+             TEST_FUNC(test_lmt_codec11), TEST_FUNC(test_lmt_codec12),
+             TEST_FUNC(test_lmt_codec13), TEST_FUNC(test_lmt_codec14),
+             TEST_FUNC(test_hashreg00), TEST_FUNC(test_arc00),
+             TEST_FUNC(test_arc01), TEST_FUNC(test_arc02),
+             TEST_FUNC(test_arc03), TEST_FUNC(test_arc04),
+             TEST_FUNC(test_lmt_track00), TEST_FUNC(test_lmt_track01),
+             TEST_FUNC(test_lmt_track02), TEST_FUNC(test_fixup_registry00),
+             TEST_FUNC(test_tex_swizzle00), TEST_FUNC(test_tex_swizzle01),
+             TEST_FUNC(test_tex00), TEST_FUNC(test_tex01),
+             TEST_FUNC(test_tex02), TEST_FUNC(test_tex03),
+             TEST_FUNC(test_tex04), TEST_FUNC(test_lmt00),
+             TEST_FUNC(test_lmt01), TEST_FUNC(test_lmt02),
+             TEST_FUNC(test_lmt03), TEST_FUNC(test_lmt04));
 
   return testResult;
 }
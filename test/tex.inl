@@ -0,0 +1,221 @@
+#pragma once
+#include "revil/tex.hpp"
+#include "spike/io/binreader_stream.hpp"
+#include "spike/io/binwritter_stream.hpp"
+#include "spike/util/unit_testing.hpp"
+#include "test_random.hpp"
+#include <bit>
+#include <cstring>
+#include <sstream>
+
+// Big endian TEX 0x66 with RGBA8 texels
+static std::string MakeTestTEXPS3(uint16 width, uint16 height, uint8 numMips) {
+  std::string retVal;
+  auto Write = [&](auto value) {
+    value = std::byteswap(value);
+    retVal.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+
+  retVal.append("\0XET", 4);
+  Write(uint16(0x66));
+  Write(uint16(2)); // General texture
+  Write(numMips);
+  Write(uint8(1)); // numFaces
+  Write(width);
+  Write(height);
+  Write(uint16(0)); // arraySize
+  Write(uint32(0x15));
+
+  for (size_t c = 0; c < 4; c++) {
+    Write(std::bit_cast<uint32>(1.f));
+  }
+
+  for (size_t m = 0; m < numMips; m++) {
+    Write(uint32(0));
+  }
+
+  // Mip chain never exceeds twice the base level
+  std::string pixels(width * height * 8u, '\0');
+  TestRandom{0x7E4}.Fill(pixels);
+  retVal.append(pixels);
+
+  return retVal;
+}
+
+int test_tex00() {
+  std::stringstream str(MakeTestTEXPS3(16, 8, 3));
+  BinReaderRef_e rd(str);
+  revil::TEX loaded;
+  loaded.Load(rd);
+
+  str.clear();
+  str.seekg(0);
+  revil::TEX deferred;
+  deferred.LoadDeferred(rd);
+  TEST_EQUAL(deferred.NumTasks(), size_t(3));
+  TEST_EQUAL(deferred.buffer.size(), loaded.buffer.size());
+
+  for (size_t t = deferred.NumTasks(); t > 0; t--) {
+    deferred.RunTask(t - 1);
+  }
+
+  TEST_EQUAL(deferred.buffer, loaded.buffer);
+  TEST_EQUAL(deferred.NumTasks(), size_t(0));
+
+  // First texel of every mip is at swizzled address 0
+  const std::string source = MakeTestTEXPS3(16, 8, 3);
+  const size_t dataBegin = 36 + 3 * sizeof(uint32);
+
+  for (size_t m = 0; m < 3; m++) {
+    uint32 stored;
+    memcpy(&stored, source.data() + dataBegin + loaded.mips.offsets[m], 4);
+    uint32 texel;
+    memcpy(&texel, loaded.buffer.data() + loaded.mips.offsets[m], 4);
+    TEST_EQUAL(texel, std::byteswap(stored));
+  }
+
+  return 0;
+}
+
+int test_tex01() {
+  // 4x4 RGBA8 cubemap with 2 mips, faces stored in reverse order
+  static constexpr size_t faceSize = (16 + 4) * 4;
+  static constexpr size_t headerSize = 36 + sizeof(float) * 27 + 12 * 4;
+  std::string file;
+  auto Write = [&](auto value) {
+    file.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+
+  file.append("TEX\0", 4);
+  Write(uint16(0x66));
+  Write(uint16(3)); // Cubemap
+  Write(uint8(2));  // numMips
+  Write(uint8(6));  // numFaces
+  Write(uint16(4));
+  Write(uint16(4));
+  Write(uint16(0));
+  Write(uint32(0x15));
+  file.append(sizeof(float) * 4 + sizeof(float) * 27, '\0');
+
+  for (size_t f = 0; f < 6; f++) {
+    const uint32 faceBegin = headerSize + (5 - f) * faceSize;
+    Write(faceBegin);
+    Write(uint32(faceBegin + 16 * 4));
+  }
+
+  for (size_t f = 0; f < 6; f++) {
+    file.append(faceSize, char('a' + 5 - f));
+  }
+
+  std::stringstream str(file);
+  BinReaderRef_e rd(str);
+  revil::TEX tex;
+  tex.Load(rd);
+
+  TEST_EQUAL(tex.buffer.size(), faceSize * 6);
+
+  for (size_t f = 0; f < 6; f++) {
+    TEST_EQUAL(tex.buffer.substr(f * faceSize, faceSize),
+               std::string(faceSize, char('a' + f)));
+  }
+
+  return 0;
+}
+
+int test_tex02() {
+  const std::string source = MakeTestTEXPS3(16, 8, 3);
+
+  for (bool noMips : {false, true}) {
+    revil::Tex2DdsSettings settings;
+    settings.noMips = noMips;
+
+    std::stringstream str(source);
+    BinReaderRef_e rd(str);
+    revil::TEX loaded;
+    loaded.Load(rd);
+    std::stringstream saved;
+    BinWritterRef wrSaved(saved);
+    loaded.SaveAsDDS(wrSaved, settings);
+
+    str.clear();
+    str.seekg(0);
+    revil::TEX streamed;
+    std::stringstream written;
+    BinWritterRef wrStreamed(written);
+    streamed.StreamAsDDS(rd, wrStreamed, settings);
+
+    TEST_EQUAL(written.str(), saved.str());
+    TEST_EQUAL(streamed.buffer.empty(), true);
+    TEST_EQUAL(streamed.NumTasks(), size_t(0));
+  }
+
+  return 0;
+}
+
+int test_tex03() {
+  const std::string source = MakeTestTEXPS3(16, 8, 3);
+  std::stringstream str(source);
+  BinReaderRef_e rd(str);
+  revil::TEX loaded;
+  loaded.Load(rd);
+
+  str.clear();
+  str.seekg(0);
+  revil::TEX probed;
+  TEST_EQUAL(probed.Probe(rd) == revil::Platform::PS3, true);
+  // Nothing past mip offsets is read
+  TEST_EQUAL(rd.Tell(), size_t(36 + 3 * sizeof(uint32)));
+  TEST_EQUAL(probed.buffer.empty(), true);
+  TEST_EQUAL(probed.NumTasks(), size_t(0));
+  TEST_EQUAL(probed.asDDS.width, loaded.asDDS.width);
+  TEST_EQUAL(probed.asDDS.height, loaded.asDDS.height);
+  TEST_EQUAL(probed.asDDS.mipMapCount, loaded.asDDS.mipMapCount);
+  TEST_EQUAL(probed.asDDS.dxgiFormat, loaded.asDDS.dxgiFormat);
+
+  for (size_t m = 0; m < 3; m++) {
+    TEST_EQUAL(probed.mips.offsets[m], loaded.mips.offsets[m]);
+    TEST_EQUAL(probed.mips.sizes[m], loaded.mips.sizes[m]);
+  }
+
+  str.clear();
+  str.seekg(0);
+  TEST_EQUAL(
+      probed.Probe(rd, revil::Platform::Win32) == revil::Platform::Win32, true);
+
+  return 0;
+}
+
+int test_tex04() {
+  // TEX 0x87 BC1 8x8, pixels are used as stored
+  std::string file;
+  auto Write = [&](auto value) {
+    file.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+
+  file.append("TEX\0", 4);
+  Write(uint16(0x87));
+  Write(uint16(0));
+  Write(uint32(2 | (1 << 4) | (1 << 9) | (8 << 17)));
+  Write(uint32(8 | (1 << 13)));
+  Write(uint32(0x13));
+  Write(uint32(24));
+  const std::string pixels = "0123456789abcdefghijklmnopqrstuv";
+  file.append(pixels);
+
+  std::stringstream str(file);
+  BinReaderRef_e rd(str);
+  revil::TEX loaded;
+  loaded.Load(rd);
+  TEST_EQUAL(loaded.buffer, pixels);
+
+  str.clear();
+  str.seekg(0);
+  revil::TEX streamed;
+  std::stringstream written;
+  BinWritterRef wr(written);
+  streamed.StreamAsDDS(rd, wr, {});
+  TEST_EQUAL(written.str().substr(written.str().size() - pixels.size()),
+             pixels);
+
+  return 0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "spike/gpu/addr_ps3.hpp"
+#include "spike/util/unit_testing.hpp"
+#include "test_random.hpp"
+#include "tex_swizzle.hpp"
+#include <bit>
+#include <cstring>
+
+static std::string MakeTiledData(size_t size) {
+  std::string retVal(size, '\0');
+  TestRandom{0x7E5}.Fill(retVal);
+
+  return retVal;
+}
+
+int test_tex_swizzle00() {
+  const uint32 sizes[][2]{{1, 1}, {4, 4}, {64, 16}, {8, 128}, {2, 256}};
+
+  for (auto [width, height] : sizes) {
+    const size_t linearSize = width * height * sizeof(uint32);
+    const std::string src = MakeTiledData(linearSize);
+    std::string dst(linearSize, '\0');
+    DeswizzlePS3RGBA8(src, dst, width, height);
+
+    MortonSettings mset(width, height);
+
+    for (uint32 y = 0; y < height; y++) {
+      for (uint32 x = 0; x < width; x++) {
+        uint32 expected;
+        memcpy(&expected, src.data() + MortonAddr(x, y, mset) * 4, 4);
+        uint32 texel;
+        memcpy(&texel, dst.data() + (y * width + x) * 4, 4);
+        TEST_EQUAL(texel, std::byteswap(expected));
+      }
+    }
+  }
+
+  return 0;
+}
+
+int test_tex_swizzle01() {
+  const size_t sizes[][2]{{1, 1}, {8, 8}, {25, 25}, {64, 3}, {13, 40}};
+
+  for (size_t blockSize : {1, 2, 4, 8, 16}) {
+    for (auto [width, height] : sizes) {
+      const size_t linearSize = width * height * blockSize;
+      const std::string src =
+          MakeTiledData(PS4TiledSize(width, height, blockSize));
+      std::string dst(linearSize, '\0');
+      DeswizzlePS4(src, dst, width, height, blockSize);
+      const size_t pitch = PS4TiledPitch(width);
+
+      for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+          const size_t addr = AddrPS4(x, y, pitch) * blockSize;
+          TEST_EQUAL(memcmp(dst.data() + (y * width + x) * blockSize,
+                            src.data() + addr, blockSize),
+                     0);
+        }
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,135 @@
+/*  ARCConvert
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "revil/arc.hpp"
+#include "spike/reflect/reflector.hpp"
+#include <set>
+#include <string>
+
+enum class ARCPreset { Fast, Balanced, Max };
+
+REFLECT(ENUMERATION(ARCPreset), ENUM_MEMBER(Fast), ENUM_MEMBER(Balanced),
+        ENUM_MEMBER(Max));
+
+inline int PresetLevel(ARCPreset preset) {
+  switch (preset) {
+  case ARCPreset::Fast:
+    return revil::ARCCodec::LEVEL_FASTEST;
+  case ARCPreset::Balanced:
+    return revil::ARCCodec::LEVEL_DEFAULT;
+  default:
+    return revil::ARCCodec::LEVEL_BEST;
+  }
+}
+
+struct ARCCompressSettings {
+  ARCPreset preset = ARCPreset::Max;
+  uint32 windowBits = 15;
+  size_t minFileSize = 0;
+  size_t ratioThreshold = 100; // percent
+  bool forceZLIBHeader = false;
+  bool probeIncompressible = false;
+  std::set<std::string, std::less<>> storedExtensions;
+
+  // Comma separated list
+  void StoredExtensions(std::string_view list) {
+    storedExtensions.clear();
+
+    while (!list.empty()) {
+      const size_t comma = list.find(',');
+      auto ext = list.substr(0, comma);
+
+      while (ext.starts_with('.') || ext.starts_with(' ')) {
+        ext.remove_prefix(1);
+      }
+
+      while (ext.ends_with(' ')) {
+        ext.remove_suffix(1);
+      }
+
+      if (!ext.empty()) {
+        storedExtensions.emplace(ext);
+      }
+
+      list.remove_prefix(comma == list.npos ? list.size() : comma + 1);
+    }
+  }
+};
+
+struct ARCCompressResult {
+  std::string_view data;
+  bool compressed = false;  // data is zlib stream
+  bool ratioFailed = false; // compression was tried, but didn't pay off
+};
+
+// Size of sample compressed before whole entry
+static constexpr size_t ARC_PROBE_SIZE = 0x4000;
+// Sample ratio (percent) from which entry is considered incompressible
+static constexpr size_t ARC_PROBE_RATIO = 97;
+
+// Returns data as stored in archive, points either to in or outBuffer
+inline ARCCompressResult
+CompressARCEntry(std::string_view in, std::string_view extension,
+                 const ARCCompressSettings &settings, std::string &outBuffer,
+                 revil::ARCCodec &codec = revil::ARCCodec::ThreadContext()) {
+  ARCCompressResult result;
+
+  auto Deflate = [&](std::string_view data, int level) {
+    outBuffer.resize(revil::ARCCodec::DeflateBound(data.size()));
+    const size_t outSize =
+        codec.Deflate(data, outBuffer, level, settings.windowBits);
+    return std::string_view(outBuffer.data(), outSize);
+  };
+
+  auto Ratio = [](size_t compressed, size_t uncompressed) {
+    return compressed * 100 / std::max(uncompressed, size_t(1));
+  };
+
+  bool tryCompress = in.size() > settings.minFileSize &&
+                     !settings.storedExtensions.contains(extension);
+
+  // Cheap trial on prefix sample, avoids full compression of
+  // already compressed data, but can miss entries with incompressible header
+  if (tryCompress && settings.probeIncompressible &&
+      in.size() >= ARC_PROBE_SIZE * 4) {
+    auto sample = Deflate(in.substr(0, ARC_PROBE_SIZE),
+                          revil::ARCCodec::LEVEL_FASTEST);
+    tryCompress = Ratio(sample.size(), ARC_PROBE_SIZE) < ARC_PROBE_RATIO;
+    result.ratioFailed = !tryCompress;
+  }
+
+  if (tryCompress) {
+    result.data = Deflate(in, PresetLevel(settings.preset));
+
+    if (Ratio(result.data.size(), in.size()) <= settings.ratioThreshold) {
+      result.compressed = true;
+      return result;
+    }
+
+    result.ratioFailed = true;
+  }
+
+  if (settings.forceZLIBHeader) {
+    result.data = Deflate(in, revil::ARCCodec::LEVEL_STORE);
+    result.compressed = true;
+  } else {
+    result.data = in;
+  }
+
+  return result;
+}
@@ -19,7 +19,6 @@
 #include "arc.hpp"
 #include "re_common.hpp"
 #include "revil/hashreg.hpp"
-#include "zlib.h"
 #include <iomanip>
 #include <sstream>
 
@@ -0,0 +1,92 @@
+/*  ARCConvert
+    Copyright(C) 2021-2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "arc.hpp"
+#include "revil/arc.hpp"
+#include "spike/crypto/blowfish.h"
+#include <mutex>
+#include <optional>
+#include <string>
+
+struct ARCDecompressSettings {
+  const BlowfishEncoder *enc = nullptr; // ARCC only, copied by workers
+  uint32 lzxWindowBits = 0;             // 0 = zlib
+  bool rawSameSize = false;             // PS3 stores raw data when sizes match
+};
+
+// Decompression state and buffers owned by single worker
+struct ARCDecompressor {
+  ARCDecompressSettings settings;
+  std::string inBuffer;
+  std::string outBuffer;
+  revil::ARCCodec codec;
+  std::optional<BlowfishEncoder> enc; // Keyed copy of settings.enc
+
+  template <class ARCFilesType>
+  ARCDecompressor(ARCDecompressSettings settings_, const ARCFilesType &files)
+      : settings(settings_) {
+    if (settings.enc) {
+      enc.emplace(*settings.enc);
+    }
+
+    size_t maxSize = 0;
+    size_t maxSizeUnc = 0x8000;
+
+    for (auto &f : files) {
+      maxSize = std::max(maxSize, size_t(f.compressedSize));
+      maxSizeUnc = std::max(maxSizeUnc, size_t(f.uncompressedSize));
+    }
+
+    inBuffer.resize(maxSize);
+    outBuffer.resize(maxSizeUnc);
+  }
+
+  // Reading from shared stream is guarded by readMutex
+  template <class ARCFileType>
+  std::string_view Decompress(const ARCFileType &f, BinReaderRef_e rd,
+                              std::mutex &readMutex) {
+    auto ReadData = [&](char *buffer) {
+      {
+        std::lock_guard<std::mutex> lg(readMutex);
+        rd.Seek(f.offset);
+        rd.ReadBuffer(buffer, f.compressedSize);
+      }
+
+      if (enc) {
+        enc->Decode(buffer, f.compressedSize);
+      }
+    };
+
+    if (settings.rawSameSize && f.compressedSize == f.uncompressedSize) {
+      ReadData(&outBuffer[0]);
+    } else {
+      ReadData(&inBuffer[0]);
+
+      std::string_view inData(inBuffer.data(), f.compressedSize);
+
+      if (settings.lzxWindowBits) {
+        codec.InflateLZX(inData, {outBuffer.data(), f.uncompressedSize},
+                         settings.lzxWindowBits);
+      } else {
+        codec.Inflate(inData, outBuffer);
+      }
+    }
+
+    return {outBuffer.data(), f.uncompressedSize};
+  }
+};
@@ -17,118 +17,26 @@
 
 #include "../hfs.hpp"
 #include "arc_conv.hpp"
+#include "arc_decompress.hpp"
 #include "project.h"
-#include "spike/crypto/blowfish.h"
 #include "spike/io/fileinfo.hpp"
 #include "spike/master_printer.hpp"
-
-#include "lzx.h"
-#include "mspack.h"
-
-#pragma region XMemDecompress
-
-struct mspack_file {
-  uint8 *buffer;
-  uint32 bufferSize;
-  uint32 position;
-  uint32 rest;
-};
-
-// https://github.com/gildor2/UEViewer/blob/master/Unreal/UnCoreCompression.cpp#L90
-static int mspack_read(mspack_file *file, void *buffer, int bytes) {
-  if (!file->rest) {
-    // read block header
-    if (file->buffer[file->position] == 0xFF) {
-      // [0]   = FF
-      // [1,2] = uncompressed block size
-      // [3,4] = compressed block size
-      file->rest = (file->buffer[file->position + 3] << 8) |
-                   file->buffer[file->position + 4];
-      file->position += 5;
-    } else {
-      // [0,1] = compressed size
-      file->rest = (file->buffer[file->position + 0] << 8) |
-                   file->buffer[file->position + 1];
-      file->position += 2;
-    }
-
-    if (file->rest > file->bufferSize - file->position) {
-      file->rest = file->bufferSize - file->position;
-    }
-  }
-
-  if (bytes > file->rest) {
-    bytes = file->rest;
-  }
-
-  if (bytes <= 0) {
-    return 0;
-  }
-
-  memcpy(buffer, file->buffer + file->position, bytes);
-  file->position += bytes;
-  file->rest -= bytes;
-
-  return bytes;
-}
-
-static int mspack_write(mspack_file *file, void *buffer, int bytes) {
-  if (bytes <= 0) {
-    return 0;
-  }
-
-  memcpy(file->buffer + file->position, buffer, bytes);
-  file->position += bytes;
-  return bytes;
-}
-
-static mspack_system mspackSystem{
-    nullptr,                                                     // open
-    nullptr,                                                     // close
-    mspack_read,                                                 // read
-    mspack_write,                                                // write
-    nullptr,                                                     // seek
-    nullptr,                                                     // tell
-    nullptr,                                                     // message
-    [](mspack_system *, size_t bytes) { return malloc(bytes); }, // alloc
-    free,                                                        // free
-    [](void *src, void *dst, size_t bytes) { memcpy(dst, src, bytes); }, // copy
-};
-
-static void DecompressLZX(char *inBuffer, uint32 compressedSize,
-                          char *outBuffer, uint32 uncompressedSize,
-                          uint32 wBits) {
-  mspack_file inStream{};
-  mspack_file outStream{};
-  inStream.buffer = reinterpret_cast<uint8 *>(inBuffer);
-  inStream.bufferSize = compressedSize;
-  outStream.buffer = reinterpret_cast<uint8 *>(outBuffer);
-  outStream.bufferSize = uncompressedSize;
-
-  lzxd_stream *lzxd = lzxd_init(&mspackSystem, &inStream, &outStream, wBits, 0,
-                                1 << wBits, uncompressedSize, false);
-
-  int retVal = lzxd_decompress(lzxd, uncompressedSize);
-
-  if (retVal != MSPACK_ERR_OK) {
-    throw std::runtime_error("LZX decompression error " +
-                             std::to_string(retVal));
-  }
-
-  lzxd_free(lzxd);
-}
-
-#pragma endregion
+#include "work_stealing.hpp"
+#include <optional>
 
 static struct ARCExtract : ReflectorBase<ARCExtract> {
   std::string title;
   Platform platform = Platform::Auto;
+  uint32 numWorkers = 1;
 } settings;
 
 REFLECT(CLASS(ARCExtract),
         MEMBER(title, "t", ReflDesc{"Set title for correct archive handling."}),
         MEMBER(platform, "p",
-               ReflDesc{"Set platform for correct archive handling."}));
+               ReflDesc{"Set platform for correct archive handling."}),
+        MEMBERNAME(numWorkers, "workers", "w",
+                   ReflDesc{"Number of threads decompressing entries of a "
+                            "single archive. 0 = all cores."}));
 
 std::string_view filters[]{
     ".arc$",
@@ -167,15 +75,15 @@ auto ReadARCC(BinReaderRef_e rd, BlowfishEncoder &enc) {
 }
 
 void AppProcessFile(AppContext *ctx) {
-  std::stringstream backup;
+  std::optional<HFSStream> hfs;
   uint32 id;
   ctx->GetType(id);
   ARC hdr;
   BinReaderRef_e rd(ctx->GetStream());
 
   if (id == SFHID) {
-    backup = ProcessHFS(rd);
-    rd = BinReaderRef_e(backup);
+    hfs.emplace(ctx->GetStream());
+    rd = BinReaderRef_e(*hfs);
     rd.Push();
     rd.Read(id);
     rd.Pop();
@@ -194,6 +102,7 @@ void AppProcessFile(AppContext *ctx) {
   }
 
   BlowfishEncoder enc;
+  const revil::ExtensionResolver resolver(settings.title, platform);
 
   auto WriteFiles = [&](auto &files) {
     auto ectx = ctx->ExtractContext();
@@ -205,73 +114,36 @@ void AppProcessFile(AppContext *ctx) {
       ectx->GenerateFolders();
     }
 
-    std::string inBuffer;
-    std::string outBuffer;
-    [&inBuffer, &outBuffer, &files] {
-      size_t maxSize = 0;
-      size_t maxSizeUnc = 0;
-
-      for (auto &f : files) {
-        if (f.uncompressedSize > maxSizeUnc) {
-          maxSizeUnc = f.uncompressedSize;
-        }
+    ARCDecompressSettings dSettings;
+    dSettings.rawSameSize = platform == Platform::PS3;
 
-        if (f.compressedSize > maxSize) {
-          maxSize = f.compressedSize;
-        }
-      }
+    if (id == ARCCID) {
+      dSettings.enc = &enc;
+    }
 
-      if (maxSizeUnc < 0x8000) {
-        maxSizeUnc = 0x8000;
-      }
+    if (hdr.version == 0x11 && hdr.LZXTag) {
+      dSettings.lzxWindowBits = id == ARCID ? 17 : 15;
+    }
 
-      inBuffer.resize(maxSize);
-      outBuffer.resize(maxSizeUnc);
-    }();
+    const size_t numWorkers = NumWorkers(settings.numWorkers, files.size());
+    std::vector<std::unique_ptr<ARCDecompressor>> workers;
 
-    for (auto &f : files) {
-      if (!f.compressedSize) {
-        continue;
-      }
+    for (size_t w = 0; w < numWorkers; w++) {
+      workers.emplace_back(std::make_unique<ARCDecompressor>(dSettings, files));
+    }
 
-      rd.Seek(f.offset);
+    std::mutex readMutex;
+    std::mutex writeMutex;
 
-      if (platform == Platform::PS3 && f.compressedSize == f.uncompressedSize) {
-        rd.ReadBuffer(&outBuffer[0], f.compressedSize);
+    RunWorkStealing(numWorkers, files.size(), [&](size_t worker, size_t index) {
+      auto &f = files[index];
 
-        if (id == ARCCID) {
-          enc.Decode(&outBuffer[0], f.compressedSize);
-        }
-      } else {
-        rd.ReadBuffer(&inBuffer[0], f.compressedSize);
-
-        if (id == ARCCID) {
-          enc.Decode(&inBuffer[0], f.compressedSize);
-        }
-
-        if (hdr.version == 0x11 && hdr.LZXTag) {
-          DecompressLZX(&inBuffer[0], f.compressedSize, &outBuffer[0],
-                        f.uncompressedSize, id == ARCID ? 17 : 15);
-        } else {
-          z_stream infstream;
-          infstream.zalloc = Z_NULL;
-          infstream.zfree = Z_NULL;
-          infstream.opaque = Z_NULL;
-          infstream.avail_in = f.compressedSize;
-          infstream.next_in = reinterpret_cast<Bytef *>(&inBuffer[0]);
-          infstream.avail_out = outBuffer.size();
-          infstream.next_out = reinterpret_cast<Bytef *>(&outBuffer[0]);
-          inflateInit(&infstream);
-          int state = inflate(&infstream, Z_FINISH);
-          inflateEnd(&infstream);
-
-          if (state < 0) {
-            throw std::runtime_error(infstream.msg);
-          }
-        }
+      if (!f.compressedSize) {
+        return;
       }
 
-      auto ext = revil::GetExtension(f.typeHash, settings.title, platform);
+      auto data = workers[worker]->Decompress(f, rd, readMutex);
+      auto ext = resolver(f.typeHash);
       std::string filePath = f.fileName;
       filePath.push_back('.');
 
@@ -283,9 +155,10 @@ void AppProcessFile(AppContext *ctx) {
         filePath.append(ext);
       }
 
+      std::lock_guard<std::mutex> lg(writeMutex);
       ectx->NewFile(filePath);
-      ectx->SendData({outBuffer.data(), f.uncompressedSize});
-    }
+      ectx->SendData(data);
+    });
   };
 
   auto ts = revil::GetTitleSupport(settings.title, settings.platform);
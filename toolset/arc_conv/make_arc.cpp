@@ -15,14 +15,18 @@
     along with this program.If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "append_file.hpp"
+#include "arc_compress.hpp"
 #include "arc_conv.hpp"
 #include "project.h"
-#include "spike/io/binreader.hpp"
+#include "revil/arc.hpp"
 #include "spike/io/binwritter.hpp"
+#include "spike/io/binwritter_stream.hpp"
 #include "spike/io/stat.hpp"
 #include "spike/master_printer.hpp"
 #include <algorithm>
 #include <atomic>
+#include <fstream>
 #include <mutex>
 #include <thread>
 
@@ -30,6 +34,9 @@ static struct ARCMake : ReflectorBase<ARCMake> {
   std::string title;
   Platform platform = Platform::Auto;
   bool forceZLIBHeader = false;
+  ARCPreset preset = ARCPreset::Max;
+  std::string storedExtensions;
+  bool probeIncompressible = false;
 } settings;
 
 REFLECT(CLASS(ARCMake),
@@ -38,7 +45,18 @@ REFLECT(CLASS(ARCMake),
                ReflDesc{"Set platform for correct archive handling."}),
         MEMBERNAME(forceZLIBHeader, "force-zlib-header", "z",
                    ReflDesc{"Force ZLIB header for files that won't be "
-                            "compressed. (Some platforms only)"}));
+                            "compressed. (Some platforms only)"}),
+        MEMBER(preset, "c",
+               ReflDesc{"Compression preset, trades packing time for archive "
+                        "size."}),
+        MEMBERNAME(storedExtensions, "stored-extensions", "s",
+                   ReflDesc{"Comma separated extensions that are never "
+                            "compressed, for example already compressed "
+                            "audio: at3,sngw,msf,mca,xsew"}),
+        MEMBERNAME(probeIncompressible, "probe-incompressible", "i",
+                   ReflDesc{"Compress 16KB sample of files from 64KB first "
+                            "and store file when sample doesn't shrink "
+                            "under 97%."}));
 
 static AppInfo_s appInfo{
     .header = ARCConvert_DESC " v" ARCConvert_VERSION ", " ARCConvert_COPYRIGHT
@@ -50,7 +68,7 @@ AppInfo_s *AppInitModule() { return &appInfo; }
 
 struct AFile {
   std::string path;
-  size_t offset;
+  size_t offset; // inside thread stream
   uint32 hash;
   uint32 uSize;
   uint32 cSize;
@@ -69,25 +87,37 @@ struct ArcMakeContext : AppPackContext {
   std::string outArc;
   std::map<std::thread::id, Stream> streams;
   const TitleSupport *ts;
+  ARCCompressSettings cSettings;
   static inline std::atomic_uint32_t numFiles; // fugly
+  static inline std::mutex streamsMutex;
 
-  Stream &NewStream() {
-    static std::mutex streamsMutex;
+  // Every thread compresses into its own temporary data file
+  Stream &ThreadStream() {
+    std::lock_guard<std::mutex> lg(streamsMutex);
     auto thisId = std::this_thread::get_id();
-    uint32 threadId = reinterpret_cast<uint32 &>(thisId);
-    std::string path = outArc + std::to_string(threadId) + ".data";
+    auto found = streams.find(thisId);
 
-    {
-      std::lock_guard<std::mutex> lg(streamsMutex);
-      streams.emplace(thisId, std::move(path));
-      return streams.at(thisId);
+    if (!es::IsEnd(streams, found)) {
+      return found->second;
     }
+
+    std::string path = outArc + std::to_string(streams.size()) + ".data";
+    return streams.emplace(thisId, std::move(path)).first->second;
   }
 
   ArcMakeContext() = default;
   ArcMakeContext(const std::string &path, const AppPackStats &)
       : outArc(path),
-        ts(revil::GetTitleSupport(settings.title, settings.platform)) {}
+        ts(revil::GetTitleSupport(settings.title, settings.platform)) {
+    auto &compressSettings = appInfo.internalSettings->compressSettings;
+    cSettings.preset = settings.preset;
+    cSettings.windowBits = ts->arc.windowSize;
+    cSettings.minFileSize = compressSettings.minFileSize;
+    cSettings.ratioThreshold = compressSettings.ratioThreshold;
+    cSettings.forceZLIBHeader = settings.forceZLIBHeader;
+    cSettings.StoredExtensions(settings.storedExtensions);
+    cSettings.probeIncompressible = settings.probeIncompressible;
+  }
   ArcMakeContext &operator=(ArcMakeContext &&) = default;
 
   void SendFile(std::string_view path, std::istream &stream) override {
@@ -125,41 +155,11 @@ struct ArcMakeContext : AppPackContext {
     const size_t streamSize = stream.tellg();
     stream.seekg(0);
 
-    std::string buffer;
+    std::string buffer(streamSize, 0);
     std::string outBuffer;
+    stream.read(buffer.data(), streamSize);
 
-    auto CompressData = [&](auto &&buffer, int cType) {
-      outBuffer.resize(std::max(buffer.size() + 0x10, size_t(0x8000)));
-      z_stream infstream;
-      infstream.zalloc = Z_NULL;
-      infstream.zfree = Z_NULL;
-      infstream.opaque = Z_NULL;
-      infstream.avail_in = buffer.size();
-      infstream.next_in = reinterpret_cast<Bytef *>(&buffer[0]);
-      infstream.avail_out = outBuffer.size();
-      infstream.next_out = reinterpret_cast<Bytef *>(&outBuffer[0]);
-
-      deflateInit2(&infstream, cType, Z_DEFLATED, ts->arc.windowSize, 8,
-                   Z_DEFAULT_STRATEGY);
-      int state = deflate(&infstream, Z_FINISH);
-      deflateEnd(&infstream);
-
-      if (state != Z_STREAM_END) {
-        throw std::runtime_error("Compression Error!");
-      }
-
-      return infstream.total_out;
-    };
-
-    auto found = streams.find(std::this_thread::get_id());
-    Stream *tStream = nullptr;
-
-    if (es::IsEnd(streams, found)) {
-      tStream = &NewStream();
-    } else {
-      tStream = &found->second;
-    }
-
+    Stream *tStream = &ThreadStream();
     auto &streamStore = tStream->streamStore;
     AFile curFile;
     curFile.offset = streamStore.Tell();
@@ -167,131 +167,68 @@ struct ArcMakeContext : AppPackContext {
     curFile.uSize = streamSize;
     curFile.path = noExt;
 
-    bool processed = false;
-    size_t compressedSize = streamSize;
-    const size_t minFileSize =
-        appInfo.internalSettings->compressSettings.minFileSize;
-    const size_t ratioThreshold =
-        appInfo.internalSettings->compressSettings.ratioThreshold;
-    const size_t verbosityLevel = appInfo.internalSettings->verbosity;
-
-    if (streamSize > minFileSize || settings.forceZLIBHeader) {
-      buffer.resize(streamSize);
-      stream.read(&buffer[0], streamSize);
-    } else {
-      outBuffer.resize(streamSize);
-      stream.read(&outBuffer[0], streamSize);
-      processed = true;
-    }
-
-    if (!processed && streamSize > minFileSize) {
-      compressedSize = CompressData(buffer, Z_BEST_COMPRESSION);
+    auto result = CompressARCEntry(buffer, extension, cSettings, outBuffer);
 
-      uint32 ratio = ((float)compressedSize / (float)streamSize) * 100;
-
-      if (ratio <= ratioThreshold) {
-        processed = true;
-      }
+    if (result.ratioFailed && appInfo.internalSettings->verbosity) {
+      printline("Ratio fail for " << path);
     }
 
-    [&] {
-      if (!processed) { // compressed with failed ratio or uncompressed data
-        if (compressedSize != streamSize && verbosityLevel) {
-          printline("Ratio fail "
-                    << ((float)compressedSize / (float)streamSize) * 100
-                    << "%% for " << path);
-        }
-
-        if (settings.forceZLIBHeader) {
-          compressedSize = CompressData(buffer, Z_NO_COMPRESSION);
-        } else { // compressed with failed ratio
-          compressedSize = streamSize;
-          streamStore.WriteBuffer(buffer.data(), compressedSize);
-          return;
-        }
-      }
-
-      streamStore.WriteBuffer(outBuffer.data(), compressedSize);
-    }();
-
+    const size_t compressedSize = result.data.size();
+    streamStore.WriteBuffer(result.data.data(), compressedSize);
     curFile.cSize = compressedSize;
     tStream->files.emplace_back(std::move(curFile));
   }
 
   void Finish() override {
-    BinWritter wr(outArc);
-    ARCBase arc;
-    arc.numFiles = numFiles;
-    arc.version = ts->arc.version;
-
-    if (arc.version < 10 || ts->arc.xmemOnly) {
-      wr.Write(arc);
-    } else {
-      ARC arcEx{arc};
-      wr.Write(arcEx);
+    struct FileRef {
+      const AFile *file;
+      const std::string *streamPath;
+    };
+
+    std::vector<FileRef> files;
+    files.reserve(numFiles);
+
+    for (auto &[_, stream] : streams) {
+      es::Dispose(stream.streamStore);
+
+      for (auto &f : stream.files) {
+        files.push_back({&f, &stream.streamPath});
+      }
     }
 
-    const size_t dataOffset =
-        wr.Tell() + arc.numFiles * ts->arc.extendedFilePath
-            ? sizeof(ARCExtendedFile)
-            : sizeof(ARCFile);
+    // Threads finish in random order, entries are sorted by input path
+    // so the same folder always produces the same archive
+    std::ranges::sort(files, {}, [](const FileRef &f) {
+      return std::tie(f.file->path, f.file->hash);
+    });
 
-    std::vector<AFile> files;
-    size_t curOffset = dataOffset;
+    std::vector<revil::ARCWriteEntry> entries;
+    entries.reserve(files.size());
 
-    for (auto &[_, stream] : streams) {
-      auto &tFiles = stream.files;
-      std::transform(tFiles.begin(), tFiles.end(), std::back_inserter(files),
-                     [&](auto &&item) {
-                       item.offset += curOffset;
-                       return std::move(item);
-                     });
-      curOffset = dataOffset + tFiles.back().cSize + tFiles.back().offset;
+    for (auto &[f, _] : files) {
+      entries.push_back({f->path, f->hash, f->cSize, f->uSize});
     }
 
-    auto WriteFile = [&](auto cFile, auto &f) {
-      cFile.offset = f.offset;
-      cFile.typeHash = f.hash;
-      memcpy(cFile.fileName, f.path.data(), f.path.size());
-      cFile.uncompressedSize = f.uSize;
-      cFile.compressedSize = f.cSize;
+    {
+      std::ofstream str(outArc, std::ios::binary);
 
-      if (settings.platform == Platform::Win32) {
-        std::replace(std::begin(cFile.fileName), std::end(cFile.fileName), '/',
-                     '\\');
+      if (!str) {
+        throw std::runtime_error("Cannot create file: " + outArc);
       }
-    };
 
-    if (ts->arc.extendedFilePath) {
-      for (auto &f : files) {
-        ARCExtendedFile cFile{};
-        WriteFile(cFile, f);
-      }
-    } else {
-      for (auto &f : files) {
-        ARCFile cFile{};
-        WriteFile(cFile, f);
-      }
+      revil::WriteARCHeader(BinWritterRef_e(str), entries, ts->arc,
+                            settings.platform);
     }
 
-    for (auto &[_, stream] : streams) {
-      es::Dispose(stream.streamStore);
-      BinReader_t<BinCoreOpenMode::NoBuffer> rd(stream.streamPath);
-      const size_t fSize = rd.GetSize();
-      char buffer[0x80000];
-      const size_t numBlocks = fSize / sizeof(buffer);
-      const size_t restBytes = fSize % sizeof(buffer);
-
-      for (size_t b = 0; b < numBlocks; b++) {
-        rd.Read(buffer);
-        wr.Write(buffer);
-      }
+    {
+      FileAppender appender(outArc);
 
-      if (restBytes) {
-        rd.ReadBuffer(buffer, restBytes);
-        wr.WriteBuffer(buffer, restBytes);
+      for (auto &[f, streamPath] : files) {
+        appender.Append(*streamPath, f->offset, f->cSize);
       }
+    }
 
+    for (auto &[_, stream] : streams) {
       es::RemoveFile(stream.streamPath);
     }
   }
@@ -0,0 +1,137 @@
+/*  ARCExtractBenchmark
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "../hfs.hpp"
+#include "arc_conv.hpp"
+#include "arc_decompress.hpp"
+#include "best_time.hpp"
+#include "project.h"
+#include "spike/master_printer.hpp"
+#include "work_stealing.hpp"
+
+static struct ARCExtractBenchmark : ReflectorBase<ARCExtractBenchmark> {
+  std::string title;
+  Platform platform = Platform::Auto;
+  uint32 maxWorkers = 0;
+  uint32 numRuns = 3;
+} settings;
+
+REFLECT(CLASS(ARCExtractBenchmark),
+        MEMBER(title, "t", ReflDesc{"Set title for correct archive handling."}),
+        MEMBER(platform, "p",
+               ReflDesc{"Set platform for correct archive handling."}),
+        MEMBERNAME(maxWorkers, "max-workers", "w",
+                   ReflDesc{"Highest thread count to measure. 0 = all cores."}),
+        MEMBERNAME(numRuns, "runs", "r",
+                   ReflDesc{"Number of runs per thread count, best run is "
+                            "reported."}));
+
+std::string_view filters[]{
+    ".arc$",
+};
+
+static AppInfo_s appInfo{
+    .filteredLoad = true,
+    .header = ARCExtractBenchmark_DESC " v" ARCExtractBenchmark_VERSION
+                                       ", " ARCExtractBenchmark_COPYRIGHT
+                                       "Lukas Cone",
+    .settings = reinterpret_cast<ReflectorFriend *>(&settings),
+    .filters = filters,
+};
+
+AppInfo_s *AppInitModule() { return &appInfo; }
+
+// Measures entry decompression only, archive is cached in memory beforehand
+// so the results are not skewed by storage
+void AppProcessFile(AppContext *ctx) {
+  std::stringstream backup;
+  uint32 id;
+  ctx->GetType(id);
+
+  if (id == SFHID) {
+    HFSStream hfs(ctx->GetStream());
+    backup << hfs.rdbuf();
+  } else {
+    backup.str(ctx->GetBuffer());
+  }
+
+  BinReaderRef_e rd(backup);
+  rd.Push();
+  rd.Read(id);
+  rd.Pop();
+
+  auto ts = revil::GetTitleSupport(settings.title, settings.platform);
+
+  if (ts->arc.extendedFilePath || (id != ARCID && id != CRAID)) {
+    printwarning("Skipped (unsupported archive type): "
+                 << ctx->workingFile.GetFilename());
+    return;
+  }
+
+  ARC hdr;
+  ARCFiles files;
+  std::tie(hdr, files) = ReadARC(rd);
+  ARCDecompressSettings dSettings;
+  dSettings.rawSameSize = id == CRAID;
+
+  if (hdr.version == 0x11 && hdr.LZXTag) {
+    dSettings.lzxWindowBits = id == ARCID ? 17 : 15;
+  }
+
+  size_t totalSize = 0;
+
+  for (auto &f : files) {
+    totalSize += f.uncompressedSize;
+  }
+
+  const size_t maxWorkers = NumWorkers(settings.maxWorkers, files.size());
+  double singleThreadTime = 0;
+
+  for (size_t numWorkers = 1;;
+       numWorkers = std::min(numWorkers * 2, maxWorkers)) {
+    std::vector<std::unique_ptr<ARCDecompressor>> workers;
+
+    for (size_t w = 0; w < numWorkers; w++) {
+      workers.emplace_back(std::make_unique<ARCDecompressor>(dSettings, files));
+    }
+
+    std::mutex readMutex;
+    const double bestTime = BestTime(std::max(settings.numRuns, 1U), [&] {
+      RunWorkStealing(numWorkers, files.size(),
+                      [&](size_t worker, size_t index) {
+                        if (files[index].compressedSize) {
+                          workers[worker]->Decompress(files[index], rd,
+                                                      readMutex);
+                        }
+                      });
+    });
+
+    if (numWorkers == 1) {
+      singleThreadTime = bestTime;
+    }
+
+    printline(ctx->workingFile.GetFilename()
+              << " threads: " << numWorkers << " entries: " << files.size()
+              << " time: " << bestTime * 1000 << "ms throughput: "
+              << (totalSize / bestTime) / (1024 * 1024)
+              << "MB/s speedup: " << singleThreadTime / bestTime);
+
+    if (numWorkers == maxWorkers) {
+      break;
+    }
+  }
+}
@@ -0,0 +1,102 @@
+/*  FixupRegistryBenchmark
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "best_time.hpp"
+#include "fixup_registry.hpp"
+#include "revil/lmt.hpp"
+#include "revil/re_asset.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string_view>
+
+// Measures pointer fixup bookkeeping and whole file loads
+// Usage: bench_fixup_registry [numPointers] [numRuns] [files...]
+// Files ending with .lmt are loaded as LMT with every animation
+// constructed, other files are loaded as RE engine assets
+
+// Every pointer is reached twice, like tracks shared between animations
+void BenchRegistry(size_t numPointers, size_t numRuns) {
+  std::vector<uint64> slots(numPointers);
+  volatile size_t sink = 0;
+
+  const double linearTime = BestTime(numRuns, [&] {
+    std::vector<void *> ptrStore;
+
+    for (size_t pass = 0; pass < 2; pass++) {
+      for (auto &s : slots) {
+        if (std::find(ptrStore.begin(), ptrStore.end(), &s) ==
+            ptrStore.end()) {
+          ptrStore.push_back(&s);
+        }
+      }
+    }
+
+    sink = sink + ptrStore.size();
+  });
+
+  const double registryTime = BestTime(numRuns, [&] {
+    revil::FixupRegistry fixups;
+
+    for (size_t pass = 0; pass < 2; pass++) {
+      for (auto &s : slots) {
+        fixups.Insert(&s);
+      }
+    }
+
+    sink = sink + fixups.Size();
+  });
+
+  std::cout << "pointers: " << numPointers
+            << " linear store: " << linearTime * 1000
+            << "ms registry: " << registryTime * 1000
+            << "ms speedup: " << linearTime / registryTime << std::endl;
+}
+
+void BenchFile(const std::string &path, size_t numRuns) {
+  const bool isLMT = std::string_view(path).ends_with(".lmt");
+
+  const double loadTime = BestTime(numRuns, [&] {
+    if (isLMT) {
+      revil::LMT lmt;
+      lmt.LoadMapped(path);
+
+      for (size_t a = 0; a < lmt.NumBlocks(); a++) {
+        lmt.Animation(a);
+      }
+    } else {
+      revil::REAsset asset;
+      asset.Load(path);
+    }
+  });
+
+  std::cout << path << " load: " << loadTime * 1000 << "ms" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  const size_t numPointers = argc > 1 ? std::stoull(argv[1]) : 1 << 15;
+  const size_t numRuns = argc > 2 ? std::stoull(argv[2]) : 3;
+
+  for (size_t n = 1024; n <= numPointers; n *= 4) {
+    BenchRegistry(n, numRuns);
+  }
+
+  for (int a = 3; a < argc; a++) {
+    BenchFile(argv[a], numRuns);
+  }
+
+  return 0;
+}
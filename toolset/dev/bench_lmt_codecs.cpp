@@ -0,0 +1,67 @@
+/*  LMTCodecsBenchmark
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "best_time.hpp"
+#include "mtf_lmt/codecs.hpp"
+#include "test_random.hpp"
+#include <cstring>
+#include <iostream>
+
+// Measures keys per second of bulk and per key decoding
+// Usage: bench_lmt_codecs [numKeys] [numRuns]
+
+template <class C>
+void Bench(const char *name, size_t numKeys, size_t numRuns) {
+  std::vector<char> raw(numKeys * sizeof(C) + sizeof(uint64));
+  TestRandom{0x5EED}.Fill(raw);
+
+  std::span<const C> keys(reinterpret_cast<const C *>(raw.data()), numKeys);
+  std::vector<float> values(numKeys * 4);
+  LMTKeysSoA soa{values.data(), values.data() + numKeys,
+                 values.data() + numKeys * 2, values.data() + numKeys * 3};
+  volatile float sink = 0;
+
+  const double scalarTime = BestTime(numRuns, [&] {
+    DecodeKeysScalar(keys, soa);
+    sink = sink + values[numKeys / 2];
+  });
+  const double bulkTime = BestTime(numRuns, [&] {
+    DecodeKeys(keys, soa);
+    sink = sink + values[numKeys / 2];
+  });
+
+  std::cout << name << " scalar: " << (numKeys / scalarTime) / 1e6
+            << "M keys/s bulk: " << (numKeys / bulkTime) / 1e6
+            << "M keys/s speedup: " << scalarTime / bulkTime << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  const size_t numKeys = argc > 1 ? std::stoull(argv[1]) : 1 << 20;
+  const size_t numRuns = argc > 2 ? std::stoull(argv[2]) : 5;
+
+  Bench<Buf_SphericalRotation>("SphericalRotation", numKeys, numRuns);
+  Bench<Buf_LinearRotationQuat4_14bit>("LinearRotationQuat4_14bit", numKeys,
+                                       numRuns);
+  Bench<Buf_BiLinearRotationQuat4_7bit>("BiLinearRotationQuat4_7bit", numKeys,
+                                        numRuns);
+  Bench<Buf_BiLinearRotationQuat4_11bit>("BiLinearRotationQuat4_11bit",
+                                         numKeys, numRuns);
+  Bench<Buf_BiLinearRotationQuat4_9bit>("BiLinearRotationQuat4_9bit", numKeys,
+                                        numRuns);
+
+  return 0;
+}
@@ -0,0 +1,178 @@
+/*  LMTSamplingBenchmark
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "best_time.hpp"
+#include "project.h"
+#include "re_common.hpp"
+#include "revil/lmt.hpp"
+#include "spike/io/binreader_stream.hpp"
+#include "spike/master_printer.hpp"
+
+static struct LMTSamplingBenchmark : ReflectorBase<LMTSamplingBenchmark> {
+  uint32 sampleRate = 60;
+  uint32 numRuns = 3;
+} settings;
+
+REFLECT(CLASS(LMTSamplingBenchmark),
+        MEMBERNAME(sampleRate, "sample-rate", "s",
+                   ReflDesc{"Number of samples per second."}),
+        MEMBERNAME(numRuns, "runs", "r",
+                   ReflDesc{"Number of runs per mode, best run is "
+                            "reported."}));
+
+std::string_view filters[]{
+    ".lmt$",
+};
+
+static AppInfo_s appInfo{
+    .filteredLoad = true,
+    .header = LMTSamplingBenchmark_DESC " v" LMTSamplingBenchmark_VERSION
+                                        ", " LMTSamplingBenchmark_COPYRIGHT
+                                        "Lukas Cone",
+    .settings = reinterpret_cast<ReflectorFriend *>(&settings),
+    .filters = filters,
+};
+
+AppInfo_s *AppInitModule() { return &appInfo; }
+
+struct SamplingResult {
+  double time = 0;
+  float checksum = 0;
+};
+
+// Samples every track at ascending times, same pattern as lmt_to_gltf
+template <class Sampler>
+SamplingResult Measure(const LMT &lmt, size_t &numSamples, Sampler &&sampler) {
+  SamplingResult retVal;
+  uni::MotionsConst motions = lmt;
+  std::vector<float> times;
+  std::vector<Vector4A16> values;
+
+  retVal.time = BestTime(std::max(settings.numRuns, 1U), [&] {
+    Vector4A16 sum(0, 0, 0, 0);
+    numSamples = 0;
+
+    for (auto m : *motions) {
+      if (!m) {
+        continue;
+      }
+
+      m->FrameRate(settings.sampleRate);
+      times.resize(m->Duration() * settings.sampleRate + 1);
+      values.resize(times.size());
+
+      for (size_t k = 0; k < times.size(); k++) {
+        times[k] = float(k) / settings.sampleRate;
+      }
+
+      for (auto t : *m) {
+        sampler(*static_cast<const LMTTrack *>(t.get()), values, times);
+
+        for (auto &v : values) {
+          sum += v;
+        }
+
+        numSamples += times.size();
+      }
+    }
+
+    retVal.checksum = sum.X + sum.Y + sum.Z + sum.W;
+  });
+
+  return retVal;
+}
+
+using Values = std::span<Vector4A16>;
+using Times = std::span<const float>;
+
+void AppProcessFile(AppContext *ctx) {
+  LMT lmt;
+  lmt.Load(ctx->GetStream());
+  size_t numSamples = 0;
+
+  auto search =
+      Measure(lmt, numSamples, [](const LMTTrack &tm, Values out, Times times) {
+        for (size_t k = 0; k < times.size(); k++) {
+          tm.GetValue(out[k], times[k]);
+        }
+      });
+  auto cursor =
+      Measure(lmt, numSamples, [](const LMTTrack &tm, Values out, Times times) {
+        LMTTrackCursor c;
+
+        for (size_t k = 0; k < times.size(); k++) {
+          tm.GetValue(out[k], times[k], c);
+        }
+      });
+  auto batch =
+      Measure(lmt, numSamples, [](const LMTTrack &tm, Values out, Times times) {
+        tm.GetValues(out, times);
+      });
+
+  if (search.checksum != cursor.checksum || search.checksum != batch.checksum) {
+    printwarning("Sampling modes differ: " << ctx->workingFile.GetFilename());
+  }
+
+  auto Report = [&](const char *mode, const SamplingResult &result) {
+    printline(ctx->workingFile.GetFilename()
+              << " mode: " << mode << " samples: " << numSamples
+              << " time: " << result.time * 1000 << "ms per sample: "
+              << (result.time * 1e9) / std::max(numSamples, size_t(1))
+              << "ns");
+  };
+
+  Report("search", search);
+  Report("cursor", cursor);
+  Report("batch", batch);
+
+  // Whole pose evaluation, evaluators are compiled before measuring
+  uni::MotionsConst motions = lmt;
+  std::vector<LMTPoseEvaluator> evaluators;
+  std::vector<size_t> numTimes;
+
+  for (auto m : *motions) {
+    if (m) {
+      auto &evaluator = evaluators.emplace_back(
+          static_cast<const LMTAnimation &>(*m), settings.sampleRate);
+      numTimes.push_back(evaluator.Duration() * settings.sampleRate + 1);
+    }
+  }
+
+  std::vector<float> times(
+      numTimes.empty() ? 0 : *std::ranges::max_element(numTimes));
+  std::vector<LMTPose> poses(times.size());
+
+  for (size_t k = 0; k < times.size(); k++) {
+    times[k] = float(k) / settings.sampleRate;
+  }
+
+  size_t numPoses = 0;
+  const double poseTime = BestTime(std::max(settings.numRuns, 1U), [&] {
+    numPoses = 0;
+
+    for (size_t e = 0; e < evaluators.size(); e++) {
+      evaluators[e].Evaluate(std::span(poses).first(numTimes[e]),
+                             std::span(times).first(numTimes[e]));
+      numPoses += numTimes[e];
+    }
+  });
+
+  printline(ctx->workingFile.GetFilename()
+            << " mode: pose poses: " << numPoses << " time: "
+            << poseTime * 1000 << "ms poses per second: "
+            << numPoses / std::max(poseTime, 1e-9));
+}
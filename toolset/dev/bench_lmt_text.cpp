@@ -0,0 +1,91 @@
+/*  LMTTextBenchmark
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "best_time.hpp"
+#include "mtf_lmt/codecs.hpp"
+#include "test_random.hpp"
+#include <iostream>
+
+// Measures text export (ToString) and import (FromString) of track keys
+// Usage: bench_lmt_text [numKeys] [numRuns]
+
+// Vector codecs get finite values, raw codecs take any bit pattern
+template <class C> std::vector<char> MakeKeys(size_t numKeys) {
+  std::vector<char> raw(numKeys * sizeof(C));
+  TestRandom rng{0x5EED};
+
+  if constexpr (std::is_same_v<C, Buf_SingleVector3> ||
+                std::is_same_v<C, Buf_LinearVector3>) {
+    C *keys = reinterpret_cast<C *>(raw.data());
+
+    for (size_t k = 0; k < numKeys; k++) {
+      keys[k].data = Vector(float(rng.Next() >> 8) / 1000.f,
+                            -float(rng.Next() >> 16) / 7.f,
+                            float(rng.Next()) * 1e-9f);
+
+      if constexpr (std::is_same_v<C, Buf_LinearVector3>) {
+        keys[k].additiveFrames = rng.Next() >> 28;
+      }
+    }
+  } else {
+    rng.Fill(raw);
+  }
+
+  return raw;
+}
+
+template <class C>
+void Bench(const char *name, TrackTypesShared type, size_t numKeys,
+           size_t numRuns) {
+  std::vector<char> raw = MakeKeys<C>(numKeys);
+  std::unique_ptr<LMTTrackController> control(
+      LMTTrackController::CreateCodec(type));
+  control->Assign(raw.data(), raw.size(), false);
+  std::string text;
+
+  const double exportTime =
+      BestTime(numRuns, [&] { control->ToString(text, 4); });
+  const double importTime =
+      BestTime(numRuns, [&] { control->FromString(text); });
+  const double textSize = double(text.size()) / (1024 * 1024);
+
+  std::cout << name << " text: " << textSize
+            << "MB export: " << textSize / exportTime
+            << "MB/s import: " << textSize / importTime << "MB/s"
+            << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  const size_t numKeys = argc > 1 ? std::stoull(argv[1]) : 1 << 18;
+  const size_t numRuns = argc > 2 ? std::stoull(argv[2]) : 5;
+
+  Bench<Buf_SingleVector3>("SingleVector3", TrackTypesShared::SingleVector3,
+                           numKeys, numRuns);
+  Bench<Buf_LinearVector3>("LinearVector3", TrackTypesShared::LinearVector3,
+                           numKeys, numRuns);
+  Bench<Buf_SphericalRotation>("SphericalRotation",
+                               TrackTypesShared::SphericalRotation, numKeys,
+                               numRuns);
+  Bench<Buf_BiLinearVector3_16bit>("BiLinearVector3_16bit",
+                                   TrackTypesShared::BiLinearVector3_16bit,
+                                   numKeys, numRuns);
+  Bench<Buf_BiLinearRotationQuat4_11bit>(
+      "BiLinearRotationQuat4_11bit",
+      TrackTypesShared::BiLinearRotationQuat4_11bit, numKeys, numRuns);
+
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*  ARCPackBenchmark
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "../hfs.hpp"
+#include "arc_compress.hpp"
+#include "arc_conv.hpp"
+#include "arc_decompress.hpp"
+#include "best_time.hpp"
+#include "project.h"
+#include "spike/master_printer.hpp"
+#include "work_stealing.hpp"
+
+static struct ARCPackBenchmark : ReflectorBase<ARCPackBenchmark> {
+  std::string title;
+  Platform platform = Platform::Auto;
+  uint32 numWorkers = 0;
+  uint32 numRuns = 3;
+  std::string storedExtensions;
+  bool probeIncompressible = false;
+} settings;
+
+REFLECT(CLASS(ARCPackBenchmark),
+        MEMBER(title, "t", ReflDesc{"Set title for correct archive handling."}),
+        MEMBER(platform, "p",
+               ReflDesc{"Set platform for correct archive handling."}),
+        MEMBERNAME(numWorkers, "workers", "w",
+                   ReflDesc{"Number of compression threads. 0 = all cores."}),
+        MEMBERNAME(numRuns, "runs", "r",
+                   ReflDesc{"Number of runs per preset, best run is "
+                            "reported."}),
+        MEMBERNAME(storedExtensions, "stored-extensions", "s",
+                   ReflDesc{"Comma separated extensions that are never "
+                            "compressed, for example already compressed "
+                            "audio: at3,sngw,msf,mca,xsew"}),
+        MEMBERNAME(probeIncompressible, "probe-incompressible", "i",
+                   ReflDesc{"Compress 16KB sample of files from 64KB first "
+                            "and store file when sample doesn't shrink "
+                            "under 97%."}));
+
+std::string_view filters[]{
+    ".arc$",
+};
+
+static AppInfo_s appInfo{
+    .filteredLoad = true,
+    .header = ARCPackBenchmark_DESC " v" ARCPackBenchmark_VERSION
+                                    ", " ARCPackBenchmark_COPYRIGHT
+                                    "Lukas Cone",
+    .settings = reinterpret_cast<ReflectorFriend *>(&settings),
+    .filters = filters,
+};
+
+AppInfo_s *AppInitModule() { return &appInfo; }
+
+// Entries of input archive are used as packing corpus
+// Measures compression only, corpus is decompressed into memory beforehand
+void AppProcessFile(AppContext *ctx) {
+  std::stringstream backup;
+  uint32 id;
+  ctx->GetType(id);
+
+  if (id == SFHID) {
+    HFSStream hfs(ctx->GetStream());
+    backup << hfs.rdbuf();
+  } else {
+    backup.str(ctx->GetBuffer());
+  }
+
+  BinReaderRef_e rd(backup);
+  rd.Push();
+  rd.Read(id);
+  rd.Pop();
+
+  auto ts = revil::GetTitleSupport(settings.title, settings.platform);
+
+  if (ts->arc.extendedFilePath || (id != ARCID && id != CRAID)) {
+    printwarning("Skipped (unsupported archive type): "
+                 << ctx->workingFile.GetFilename());
+    return;
+  }
+
+  ARC hdr;
+  ARCFiles files;
+  std::tie(hdr, files) = ReadARC(rd);
+  ARCDecompressSettings dSettings;
+  dSettings.rawSameSize = id == CRAID;
+
+  if (hdr.version == 0x11 && hdr.LZXTag) {
+    dSettings.lzxWindowBits = id == ARCID ? 17 : 15;
+  }
+
+  const revil::ExtensionResolver resolver(
+      settings.title, id == CRAID ? Platform::PS3 : Platform::Win32);
+  std::vector<std::string> corpus;
+  std::vector<std::string_view> extensions;
+  size_t totalSize = 0;
+
+  {
+    ARCDecompressor decompressor(dSettings, files);
+    std::mutex readMutex;
+
+    for (auto &f : files) {
+      if (!f.compressedSize) {
+        continue;
+      }
+
+      corpus.emplace_back(decompressor.Decompress(f, rd, readMutex));
+      extensions.emplace_back(resolver(f.typeHash));
+      totalSize += corpus.back().size();
+    }
+  }
+
+  ARCCompressSettings cSettings;
+  cSettings.windowBits = ts->arc.windowSize;
+  auto &compressSettings = appInfo.internalSettings->compressSettings;
+  cSettings.minFileSize = compressSettings.minFileSize;
+  cSettings.ratioThreshold = compressSettings.ratioThreshold;
+  cSettings.StoredExtensions(settings.storedExtensions);
+  cSettings.probeIncompressible = settings.probeIncompressible;
+
+  const size_t numWorkers = NumWorkers(settings.numWorkers, corpus.size());
+  std::vector<std::string> outBuffers(numWorkers);
+  std::vector<size_t> storedSizes(corpus.size());
+
+  for (ARCPreset preset :
+       {ARCPreset::Fast, ARCPreset::Balanced, ARCPreset::Max}) {
+    cSettings.preset = preset;
+    const double bestTime = BestTime(std::max(settings.numRuns, 1U), [&] {
+      RunWorkStealing(numWorkers, corpus.size(),
+                      [&](size_t worker, size_t index) {
+                        storedSizes[index] =
+                            CompressARCEntry(corpus[index], extensions[index],
+                                             cSettings, outBuffers[worker])
+                                .data.size();
+                      });
+    });
+
+    size_t archiveSize = 0;
+
+    for (size_t s : storedSizes) {
+      archiveSize += s;
+    }
+
+    auto presetName = GetReflectedEnum<ARCPreset>()->names[size_t(preset)];
+
+    printline(ctx->workingFile.GetFilename()
+              << " preset: " << presetName << " threads: " << numWorkers
+              << " time: " << bestTime * 1000
+              << "ms throughput: " << (totalSize / bestTime) / (1024 * 1024)
+              << "MB/s size: " << archiveSize << " ratio: "
+              << archiveSize * 100.0 / std::max(totalSize, size_t(1)) << '%');
+  }
+}
@@ -0,0 +1,87 @@
+/*  TEXProbeBenchmark
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "best_time.hpp"
+#include "revil/tex.hpp"
+#include "spike/io/binreader_stream.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Measures metadata probes of every .tex file in directory tree against
+// full loads, files are opened for every probe like an indexer would
+// Usage: bench_tex_probe <directory> [numRuns]
+
+// Returns number of files that failed to load
+template <class Func>
+size_t ForEachTexture(const std::vector<std::string> &paths, Func &&func) {
+  size_t numFailed = 0;
+
+  for (auto &path : paths) {
+    std::ifstream str(path, std::ios::binary);
+    BinReaderRef_e rd(str);
+    revil::TEX tex;
+
+    try {
+      func(tex, rd);
+    } catch (const std::exception &) {
+      numFailed++;
+    }
+  }
+
+  return numFailed;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: bench_tex_probe <directory> [numRuns]" << std::endl;
+    return 1;
+  }
+
+  const size_t numRuns = argc > 2 ? std::stoull(argv[2]) : 5;
+  std::vector<std::string> paths;
+
+  for (auto &entry : std::filesystem::recursive_directory_iterator(argv[1])) {
+    if (entry.is_regular_file() && entry.path().extension() == ".tex") {
+      paths.emplace_back(entry.path().string());
+    }
+  }
+
+  if (paths.empty()) {
+    std::cerr << "No .tex files found." << std::endl;
+    return 1;
+  }
+
+  size_t numFailed = 0;
+  const double probeTime = BestTime(numRuns, [&] {
+    numFailed = ForEachTexture(
+        paths, [](revil::TEX &tex, BinReaderRef_e rd) { tex.Probe(rd); });
+  });
+  const double loadTime = BestTime(numRuns, [&] {
+    ForEachTexture(paths,
+                   [](revil::TEX &tex, BinReaderRef_e rd) { tex.Load(rd); });
+  });
+
+  std::cout << "files: " << paths.size() << " failed: " << numFailed
+            << " probe: " << paths.size() / probeTime
+            << " files/s load: " << paths.size() / loadTime
+            << " files/s speedup: " << loadTime / probeTime << std::endl;
+
+  return 0;
+}
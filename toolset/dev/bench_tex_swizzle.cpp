@@ -0,0 +1,92 @@
+/*  TEXSwizzleBenchmark
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "best_time.hpp"
+#include "spike/gpu/addr_ps3.hpp"
+#include "tex_swizzle.hpp"
+#include <bit>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// Measures tiled to linear conversion of per texel addressing and kernels
+// Usage: bench_tex_swizzle [size] [numRuns]
+
+void Report(const char *name, size_t numBytes, double referenceTime,
+            double kernelTime) {
+  const double size = double(numBytes) / (1024 * 1024);
+  std::cout << name << " reference: " << size / referenceTime
+            << "MB/s kernel: " << size / kernelTime
+            << "MB/s speedup: " << referenceTime / kernelTime << std::endl;
+}
+
+void BenchPS3(uint32 size, size_t numRuns) {
+  const size_t numBytes = size_t(size) * size * sizeof(uint32);
+  std::string src(numBytes, 'x');
+  std::string dst(numBytes, '\0');
+
+  const double referenceTime = BestTime(numRuns, [&] {
+    MortonSettings mset(size, size);
+
+    for (uint32 y = 0; y < size; y++) {
+      for (uint32 x = 0; x < size; x++) {
+        uint32 texel;
+        memcpy(&texel, src.data() + MortonAddr(x, y, mset) * 4, 4);
+        texel = std::byteswap(texel);
+        memcpy(dst.data() + (size_t(y) * size + x) * 4, &texel, 4);
+      }
+    }
+  });
+  const double kernelTime = BestTime(
+      numRuns, [&] { DeswizzlePS3RGBA8(src, dst, size, size); });
+
+  Report("PS3 RGBA8", numBytes, referenceTime, kernelTime);
+}
+
+void BenchPS4(const char *name, size_t size, size_t blockSize,
+              size_t numRuns) {
+  const size_t numBytes = size * size * blockSize;
+  std::string src(PS4TiledSize(size, size, blockSize), 'x');
+  std::string dst(numBytes, '\0');
+  const size_t pitch = PS4TiledPitch(size);
+
+  const double referenceTime = BestTime(numRuns, [&] {
+    for (size_t y = 0; y < size; y++) {
+      for (size_t x = 0; x < size; x++) {
+        memcpy(dst.data() + (y * size + x) * blockSize,
+               src.data() + AddrPS4(x, y, pitch) * blockSize, blockSize);
+      }
+    }
+  });
+  const double kernelTime = BestTime(
+      numRuns, [&] { DeswizzlePS4(src, dst, size, size, blockSize); });
+
+  Report(name, numBytes, referenceTime, kernelTime);
+}
+
+int main(int argc, char *argv[]) {
+  const uint32 size = argc > 1 ? std::stoul(argv[1]) : 2048;
+  const size_t numRuns = argc > 2 ? std::stoull(argv[2]) : 5;
+
+  BenchPS3(size, numRuns);
+  BenchPS4("PS4 R8", size, 1, numRuns);
+  BenchPS4("PS4 RGBA8", size, 4, numRuns);
+  BenchPS4("PS4 BC1", size / 4, 8, numRuns);
+  BenchPS4("PS4 BC3", size / 4, 16, numRuns);
+
+  return 0;
+}
@@ -0,0 +1,36 @@
+/*  Revil Toolset common stuff
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+// Returns shortest duration of numRuns calls in seconds
+template <class Func> double BestTime(size_t numRuns, Func &&func) {
+  double bestTime = std::numeric_limits<double>::max();
+
+  for (size_t r = 0; r < numRuns; r++) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    bestTime = std::min(bestTime, elapsed.count());
+  }
+
+  return bestTime;
+}
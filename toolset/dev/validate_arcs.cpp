@@ -24,6 +24,7 @@
 #include "spike/crypto/blowfish.h"
 #include "spike/io/fileinfo.hpp"
 #include "spike/master_printer.hpp"
+#include <optional>
 #include <set>
 
 static struct ValidateVFS : ReflectorBase<ValidateVFS> {
@@ -79,15 +80,15 @@ std::mutex mergeMtx;
 const MtExtensions *reg = nullptr;
 
 void AppProcessFile(AppContext *ctx) {
-  std::stringstream backup;
+  std::optional<HFSStream> hfs;
   uint32 id;
   ctx->GetType(id);
   ARC hdr;
   BinReaderRef_e rd(ctx->GetStream());
 
   if (id == SFHID) {
-    backup = ProcessHFS(rd);
-    rd = BinReaderRef_e(backup);
+    hfs.emplace(ctx->GetStream());
+    rd = BinReaderRef_e(*hfs);
     rd.Push();
     rd.Read(id);
     rd.Pop();
@@ -101,10 +102,11 @@ void AppProcessFile(AppContext *ctx) {
     reg = revil::GetTitleRegistry(settings.title);
   }
 
+  const revil::ExtensionResolver resolver(settings.title, settings.platform);
+
   auto WriteFiles = [&](auto &files) {
     for (auto &f : files) {
-      auto ext =
-          revil::GetExtension(f.typeHash, settings.title, settings.platform);
+      auto ext = resolver(f.typeHash);
 
       if (ext.empty()) {
         if (!newHashes.count(f.typeHash) && !::newHashes.count(f.typeHash)) {
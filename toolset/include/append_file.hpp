@@ -0,0 +1,166 @@
+/*  Revil Toolset common stuff
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+Appends byte ranges of source files to the end of destination file.
+Linux copies inside kernel via copy_file_range (reflinks where supported),
+other platforms or unsupported filesystems use buffered copy.
+Source files are opened once and kept open until destruction.
+*/
+class FileAppender {
+public:
+  FileAppender(const std::string &dstPath) {
+#if defined(__linux__)
+    dst = open(dstPath.c_str(), O_WRONLY);
+
+    if (dst < 0) {
+      throw std::runtime_error("Cannot open file: " + dstPath);
+    }
+
+    dstOffset = lseek(dst, 0, SEEK_END);
+#else
+    dst.open(dstPath, std::ios::binary | std::ios::app);
+
+    if (!dst) {
+      throw std::runtime_error("Cannot open file: " + dstPath);
+    }
+#endif
+  }
+
+  FileAppender(const FileAppender &) = delete;
+
+  ~FileAppender() {
+#if defined(__linux__)
+    for (auto &[_, src] : sources) {
+      close(src);
+    }
+
+    close(dst);
+#endif
+  }
+
+  void Append(const std::string &srcPath, size_t offset, size_t size) {
+#if defined(__linux__)
+    const int src = Source(srcPath);
+    off_t srcOffset = offset;
+
+    while (size && kernelCopy) {
+      const ssize_t copied =
+          copy_file_range(src, &srcOffset, dst, &dstOffset, size, 0);
+
+      if (copied < 0) {
+        kernelCopy = false; // EXDEV, ENOSYS, ...
+      }
+
+      if (copied <= 0) {
+        break;
+      }
+
+      size -= copied;
+    }
+
+    while (size) {
+      buffer.resize(std::min(size, BUFFER_SIZE));
+      const ssize_t numRead =
+          pread(src, buffer.data(), buffer.size(), srcOffset);
+
+      if (numRead <= 0 ||
+          pwrite(dst, buffer.data(), numRead, dstOffset) != numRead) {
+        throw std::runtime_error("Failed to append data from: " + srcPath);
+      }
+
+      srcOffset += numRead;
+      dstOffset += numRead;
+      size -= numRead;
+    }
+#else
+    std::ifstream &src = Source(srcPath);
+    src.seekg(offset);
+
+    while (size) {
+      buffer.resize(std::min(size, BUFFER_SIZE));
+      src.read(buffer.data(), buffer.size());
+      dst.write(buffer.data(), buffer.size());
+
+      if (!src || !dst) {
+        throw std::runtime_error("Failed to append data from: " + srcPath);
+      }
+
+      size -= buffer.size();
+    }
+#endif
+  }
+
+private:
+  static constexpr size_t BUFFER_SIZE = 0x100000;
+  std::vector<char> buffer;
+
+#if defined(__linux__)
+  int dst = -1;
+  off_t dstOffset = 0;
+  bool kernelCopy = true;
+  std::map<std::string, int> sources;
+
+  int Source(const std::string &srcPath) {
+    auto found = sources.find(srcPath);
+
+    if (found != sources.end()) {
+      return found->second;
+    }
+
+    const int src = open(srcPath.c_str(), O_RDONLY);
+
+    if (src < 0) {
+      throw std::runtime_error("Cannot open file: " + srcPath);
+    }
+
+    return sources.emplace(srcPath, src).first->second;
+  }
+#else
+  std::ofstream dst;
+  std::map<std::string, std::ifstream> sources;
+
+  std::ifstream &Source(const std::string &srcPath) {
+    auto found = sources.find(srcPath);
+
+    if (found != sources.end()) {
+      return found->second;
+    }
+
+    std::ifstream src(srcPath, std::ios::binary);
+
+    if (!src) {
+      throw std::runtime_error("Cannot open file: " + srcPath);
+    }
+
+    return sources.emplace(srcPath, std::move(src)).first->second;
+  }
+#endif
+};
@@ -0,0 +1,115 @@
+/*  Revil Toolset common stuff
+    Copyright(C) 2023 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 0 = all hardware threads
+inline size_t NumWorkers(size_t requested, size_t numItems) {
+  if (!requested) {
+    requested = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+
+  return std::max(std::min(requested, numItems), size_t(1));
+}
+
+/*
+Calls func(workerIndex, itemIndex) for every item in [0, numItems)
+Every worker owns a contiguous range of items, once a worker runs out of
+items, it steals remaining items from ranges of other workers.
+Worker 0 runs on calling thread.
+First thrown exception stops all workers and is rethrown to caller.
+*/
+template <class Func>
+void RunWorkStealing(size_t numWorkers, size_t numItems, Func &&func) {
+  numWorkers = NumWorkers(numWorkers, numItems);
+
+  if (numWorkers == 1) {
+    for (size_t i = 0; i < numItems; i++) {
+      func(size_t(0), i);
+    }
+
+    return;
+  }
+
+  struct alignas(64) WorkRange {
+    std::atomic_size_t next;
+    size_t end;
+  };
+
+  auto ranges = std::make_unique<WorkRange[]>(numWorkers);
+  const size_t rangeSize = numItems / numWorkers;
+  const size_t rangeRest = numItems % numWorkers;
+  size_t rangeBegin = 0;
+
+  for (size_t w = 0; w < numWorkers; w++) {
+    ranges[w].next = rangeBegin;
+    rangeBegin += rangeSize + (w < rangeRest);
+    ranges[w].end = rangeBegin;
+  }
+
+  std::atomic_bool failed{false};
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+
+  auto Worker = [&](size_t workerIndex) {
+    try {
+      for (size_t r = 0; r < numWorkers; r++) {
+        WorkRange &range = ranges[(workerIndex + r) % numWorkers];
+
+        for (size_t i = range.next++; i < range.end; i = range.next++) {
+          if (failed) {
+            return;
+          }
+
+          func(workerIndex, i);
+        }
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lg(exceptionMutex);
+
+      if (!exception) {
+        exception = std::current_exception();
+      }
+
+      failed = true;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numWorkers - 1);
+
+  for (size_t w = 1; w < numWorkers; w++) {
+    threads.emplace_back(Worker, w);
+  }
+
+  Worker(0);
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
@@ -23,6 +23,7 @@
 #include "spike/io/binwritter_stream.hpp"
 #include "spike/io/fileinfo.hpp"
 #include "spike/type/matrix44.hpp"
+#include "work_stealing.hpp"
 #include <set>
 
 #if 0
@@ -45,14 +46,39 @@ std::string_view controlFilters[]{
 
 static const float SCALE = 0.01;
 
+enum class KeyReduction { Strip, Adaptive };
+
+REFLECT(ENUMERATION(KeyReduction), ENUM_MEMBER(Strip), ENUM_MEMBER(Adaptive));
+
 struct LMT2GLTF : ReflectorBase<LMT2GLTF> {
   std::string modelSource;
+  uint32 numWorkers = 1;
+  KeyReduction keyReduction = KeyReduction::Strip;
+  float translationTolerance = 0.0001f;
+  float rotationTolerance = 0.05f;
+  float scaleTolerance = 0.0001f;
 } settings;
 
 REFLECT(CLASS(LMT2GLTF),
         MEMBERNAME(modelSource, "model-source", "s",
                    ReflDesc{
-                       "Set path to model gltf as a base for animtions."}));
+                       "Set path to model gltf as a base for animtions."}),
+        MEMBERNAME(numWorkers, "workers", "w",
+                   ReflDesc{"Number of threads sampling animations. Output "
+                            "does not depend on it. 0 = all cores."}),
+        MEMBERNAME(keyReduction, "key-reduction", "k",
+                   ReflDesc{"Strip removes only exactly linear samples. "
+                            "Adaptive keeps only keys needed to stay within "
+                            "tolerances. For linear codecs kept keys are a "
+                            "subset of original keyframes."}),
+        MEMBERNAME(translationTolerance, "translation-tolerance", "t",
+                   ReflDesc{"Adaptive reduction: maximal translation error in "
+                            "output units (meters)."}),
+        MEMBERNAME(rotationTolerance, "rotation-tolerance", "r",
+                   ReflDesc{"Adaptive reduction: maximal rotation error in "
+                            "degrees."}),
+        MEMBERNAME(scaleTolerance, "scale-tolerance", "c",
+                   ReflDesc{"Adaptive reduction: maximal scale error."}));
 
 static AppInfo_s appInfo{
     .filteredLoad = true,
@@ -105,7 +131,8 @@ struct AnimEngine {
   uint32 numSamples;
 };
 
-void WalkTree(AnimEngine &eng, GLTF &main, gltf::Node &glNode, int32 parent) {
+void WalkTree(AnimEngine &eng, const GLTF &main, const gltf::Node &glNode,
+              int32 parent) {
   auto found = glNode.name.find(':');
   AnimNode *aNode = nullptr;
   int32 animNodeId = -1;
@@ -148,7 +175,7 @@ void WalkTree(AnimEngine &eng, GLTF &main, gltf::Node &glNode, int32 parent) {
   }
 }
 
-void LinkNodes(AnimEngine &eng, GLTF &main) {
+void LinkNodes(AnimEngine &eng, const GLTF &main) {
   for (auto &node : main.nodes) {
     if (node.name == "reference") {
       WalkTree(eng, main, node, -1);
@@ -492,12 +519,175 @@ StripResult StripValues(std::span<SVector4> tck) {
   return retval;
 }
 
-void DumpAnim(AnimEngine &eng, LMTGLTF &main, std::string animName,
-              std::span<float> times, uint32 loopFrame, ReportType &) {
+/*
+Douglas-Peucker reduction over uniformly sampled channel.
+error(begin, end, i) returns error of sample i interpolated from kept keys
+begin and end. Samples are split at the worst sample until every segment is
+within tolerance. Linear codecs interpolate between integer frames, which are
+all present in 60 fps sampling, so their kept keys are a subset of original
+keys.
+*/
+template <class Error>
+std::vector<size_t> ReduceKeys(size_t numKeys, float tolerance,
+                               Error &&error) {
+  std::vector<size_t> retVal{0};
+
+  if (numKeys < 2) {
+    return retVal;
+  }
+
+  std::vector<bool> keep(numKeys);
+  keep.back() = true;
+  std::vector<std::pair<size_t, size_t>> segments{{0, numKeys - 1}};
+
+  while (!segments.empty()) {
+    auto [begin, end] = segments.back();
+    segments.pop_back();
+    float maxError = tolerance;
+    size_t maxIndex = 0;
+
+    for (size_t i = begin + 1; i < end; i++) {
+      if (float curError = error(begin, end, i); curError > maxError) {
+        maxError = curError;
+        maxIndex = i;
+      }
+    }
+
+    if (maxIndex) {
+      keep[maxIndex] = true;
+      segments.emplace_back(begin, maxIndex);
+      segments.emplace_back(maxIndex, end);
+    }
+  }
+
+  for (size_t i = 1; i < numKeys; i++) {
+    if (keep[i]) {
+      retVal.push_back(i);
+    }
+  }
+
+  return retVal;
+}
+
+gltfutils::StripResult ReduceValues(std::span<Vector4A16> tck,
+                                    float tolerance) {
+  auto keys = ReduceKeys(tck.size(), tolerance, [&](size_t b, size_t e,
+                                                    size_t i) {
+    const float t = float(i - b) / float(e - b);
+    Vector4A16 diff = tck[b] + (tck[e] - tck[b]) * t - tck[i];
+    diff.w = 0;
+    return diff.Length();
+  });
+
+  gltfutils::StripResult retval;
+
+  for (size_t k : keys) {
+    retval.timeIndices.push_back(k);
+    retval.values.push_back(tck[k]);
+  }
+
+  return retval;
+}
+
+StripResult ReduceValues(std::span<SVector4> tck, float toleranceDeg) {
+  auto ToQuat = [&](size_t index) {
+    Vector4A16 q = Unpack(tck[index]);
+    return glm::quat(q.w, q.x, q.y, q.z);
+  };
+
+  const float tolerance = glm::radians(toleranceDeg);
+  // Measured on packed values, as they will be written
+  auto keys =
+      ReduceKeys(tck.size(), tolerance, [&](size_t b, size_t e, size_t i) {
+        const float t = float(i - b) / float(e - b);
+        glm::quat interpolated = glm::slerp(ToQuat(b), ToQuat(e), t);
+        glm::quat sampled = ToQuat(i);
+        const float cosHalf = std::abs(glm::dot(
+            glm::normalize(interpolated), glm::normalize(sampled)));
+        return 2 * std::acos(std::min(cosHalf, 1.f));
+      });
+
+  StripResult retval;
+
+  for (size_t k : keys) {
+    retval.timeIndices.push_back(k);
+    retval.values.push_back(tck[k]);
+  }
+
+  return retval;
+}
+
+// Animation sampled and stripped by worker thread, written in motion order
+struct AnimJob {
+  const LMTAnimation *animation;
+  size_t motionIndex;
+  AnimEngine engine;
+  std::vector<float> times;
+  std::string animName;
+  uint32 loopFrame = 0;
+  std::vector<std::string> messages;
+  // Channel strips in DumpAnim write order
+  std::vector<gltfutils::StripResult> vectorStrips;
+  std::vector<StripResult> rotationStrips;
+};
+
+// Calls func(start, size) for every animation written by DumpAnim
+template <class Func> void ForEachSection(const AnimJob &job, Func &&func) {
+  if (job.loopFrame) {
+    func(0, job.loopFrame);
+    func(job.loopFrame, job.times.size() - job.loopFrame);
+  } else {
+    func(0, job.times.size());
+  }
+}
+
+void StripChannels(AnimJob &job) {
+  const bool adaptive = settings.keyReduction == KeyReduction::Adaptive;
+
+  ForEachSection(job, [&](size_t start, size_t size) {
+    for (auto &[_, node] : job.engine.nodes) {
+      if (node.glNodeIndex < 0) {
+        continue;
+      }
+
+      if (!node.positions.empty()) {
+        auto positionsSpan =
+            std::span<Vector4A16>(node.positions).subspan(start, size);
+        job.vectorStrips.emplace_back(
+            adaptive
+                ? ReduceValues(positionsSpan, settings.translationTolerance)
+                : StripValues(positionsSpan));
+      }
+
+      if (!node.rotations.empty()) {
+        auto rotationsSpan =
+            std::span<SVector4>(node.rotations).subspan(start, size);
+        job.rotationStrips.emplace_back(
+            adaptive ? ReduceValues(rotationsSpan, settings.rotationTolerance)
+                     : StripValues(rotationsSpan));
+      }
+
+      if (!node.scales.empty()) {
+        auto scalesSpan =
+            std::span<Vector4A16>(node.scales).subspan(start, size);
+        job.vectorStrips.emplace_back(
+            adaptive ? ReduceValues(scalesSpan, settings.scaleTolerance)
+                     : StripValues(scalesSpan));
+      }
+    }
+  });
+}
+
+void DumpAnim(AnimJob &job, LMTGLTF &main, ReportType &) {
+  AnimEngine &eng = job.engine;
+  std::span<float> times(job.times);
+  const uint32 loopFrame = job.loopFrame;
+  const std::string &animName = job.animName;
+  auto vectorStrip = job.vectorStrips.begin();
+  auto rotationStrip = job.rotationStrips.begin();
 
-  auto TryStripWrite = [&](auto valuesSpan, size_t keys, GLTFStream &stream,
-                           size_t accId) {
-    auto strip = StripValues(valuesSpan);
+  auto TryStripWrite = [&](auto valuesSpan, auto &strip, size_t keys,
+                           GLTFStream &stream, size_t accId) {
     const float stripRatio =
         float(strip.timeIndices.size()) / float(valuesSpan.size());
 
@@ -577,7 +767,8 @@ void DumpAnim(AnimEngine &eng, LMTGLTF &main, std::string animName,
         std::span<Vector4A16> positionsSpan(node.positions);
         positionsSpan = positionsSpan.subspan(start, size);
 
-        sampler.input = TryStripWrite(positionsSpan, keys, stream, transIndex);
+        sampler.input = TryStripWrite(positionsSpan, *vectorStrip++, keys,
+                                      stream, transIndex);
       }
 
       if (!node.rotations.empty()) {
@@ -602,7 +793,8 @@ void DumpAnim(AnimEngine &eng, LMTGLTF &main, std::string animName,
 
         std::span<SVector4> rotationsSpan(node.rotations);
         rotationsSpan = rotationsSpan.subspan(start, size);
-        sampler.input = TryStripWrite(rotationsSpan, keys, stream, transIndex);
+        sampler.input = TryStripWrite(rotationsSpan, *rotationStrip++, keys,
+                                      stream, transIndex);
       }
 
       if (!node.scales.empty()) {
@@ -629,7 +821,8 @@ void DumpAnim(AnimEngine &eng, LMTGLTF &main, std::string animName,
         std::span<Vector4A16> scalesSpan(node.scales);
         scalesSpan = scalesSpan.subspan(start, size);
 
-        sampler.input = TryStripWrite(scalesSpan, keys, stream, transIndex);
+        sampler.input = TryStripWrite(scalesSpan, *vectorStrip++, keys, stream,
+                                      transIndex);
       }
     }
 
@@ -715,99 +908,119 @@ enum LPTypes {
   Vs00LeftArmChain,  // Vs07, Vs41, Hm
 };
 
-void DoLmt(LMTGLTF &main, uni::MotionsConst motion, std::string name,
-           ReportType &report) {
-  int32 sampleRate = 60;
-  const float sampleFrac = 1.f / sampleRate;
+static const int32 SAMPLE_RATE = 60;
 
-  for (size_t motionIndex = 0; auto m : *motion) {
-    if (!m) {
-      motionIndex++;
+// Only reads main, runs on worker threads
+void PrepareAnim(const LMTGLTF &main, AnimJob &job, const std::string &name) {
+  const float sampleFrac = 1.f / SAMPLE_RATE;
+  const LMTAnimation *lm = job.animation;
+  lm->FrameRate(SAMPLE_RATE);
+  job.times = gltfutils::MakeSamples(SAMPLE_RATE, lm->Duration());
+
+  AnimEngine &engine = job.engine;
+  LinkNodes(engine, main);
+  engine.numSamples = job.times.size();
+  std::vector<Vector4A16> channel;
+  const std::span<const float> times(job.times);
+
+  for (auto t : *lm->Tracks()) {
+    size_t index = t->BoneIndex();
+
+    if (!engine.nodes.contains(index)) {
+      job.messages.emplace_back("Missing bone: " + std::to_string(index));
       continue;
     }
 
-    m->FrameRate(sampleRate);
-    auto times = gltfutils::MakeSamples(sampleRate, m->Duration());
-    auto lm = static_cast<const LMTAnimation *>(m.get());
+    AnimNode &aNode = engine.nodes.at(index);
+    auto tm = static_cast<const LMTTrack *>(t.get());
+    aNode.boneType = tm->BoneType();
 
-    AnimEngine engine;
-    LinkNodes(engine, main);
-    engine.numSamples = times.size();
+    if (aNode.boneType) {
+      job.messages.emplace_back("Index: " + std::to_string(index) +
+                                " type: " + std::to_string(aNode.boneType));
+    }
 
-    for (auto t : *m) {
-      size_t index = t->BoneIndex();
+    switch (t->TrackType()) {
+    case uni::MotionTrack::Position:
+      aNode.positions.resize(times.size());
+      aNode.positionCompression = tm->CompressionType();
+      tm->GetValues(aNode.positions, times);
 
-      if (!engine.nodes.contains(index)) {
-        printline("Missing bone: " << index);
-        continue;
+      for (auto &value : aNode.positions) {
+        value *= SCALE;
+      }
+      break;
+    case uni::MotionTrack::Rotation:
+      aNode.rotations.reserve(times.size());
+      aNode.rotationCompression = tm->CompressionType();
+      channel.resize(times.size());
+      tm->GetValues(channel, times);
+
+      for (auto &value : channel) {
+        aNode.rotations.emplace_back(Pack(value));
       }
+      break;
+    case uni::MotionTrack::Scale:
+      aNode.scales.resize(times.size());
+      aNode.scaleCompression = tm->CompressionType();
+      tm->GetValues(aNode.scales, times);
+      break;
+    default:
+      break;
+    }
+  }
 
-      AnimNode &aNode = engine.nodes.at(index);
-      auto tm = static_cast<const LMTTrack *>(t.get());
-      aNode.boneType = tm->BoneType();
+  InheritScales(engine, size_t(-1));
+  SetupChains(engine);
 
-      if (aNode.boneType) {
-        printline("Index: " << index << " type: " << int(aNode.boneType));
-      }
+  float loopTime = lm->LoopFrame() * sampleFrac;
+  job.animName = name + "[" + std::to_string(job.motionIndex) + "]";
 
-      switch (t->TrackType()) {
-      case uni::MotionTrack::Position:
-        aNode.positions.reserve(times.size());
-        aNode.positionCompression = tm->CompressionType();
+  if (loopTime == 0.f) {
+    job.animName.append("_loop");
+  }
 
-        for (auto k : times) {
-          Vector4A16 value;
-          t->GetValue(value, k);
-          value *= SCALE;
-          aNode.positions.emplace_back(value);
-        }
-        break;
-      case uni::MotionTrack::Rotation:
-        aNode.rotations.reserve(times.size());
-        aNode.rotationCompression = tm->CompressionType();
-
-        for (auto k : times) {
-          Vector4A16 value;
-          t->GetValue(value, k);
-          aNode.rotations.emplace_back(Pack(value));
-        }
-        break;
-      case uni::MotionTrack::Scale:
-        aNode.scales.reserve(times.size());
-        aNode.scaleCompression = tm->CompressionType();
-
-        for (auto k : times) {
-          Vector4A16 value;
-          t->GetValue(value, k);
-          aNode.scales.emplace_back(value);
-        }
-        break;
-      default:
-        break;
-      }
-    }
+  if (loopTime > 0.f) {
+    job.loopFrame = gltfutils::FindTimeEndIndex(job.times, loopTime);
+  }
 
-    InheritScales(engine, size_t(-1));
-    SetupChains(engine);
+  StripChannels(job);
+}
 
-    float loopTime = lm->LoopFrame() * sampleFrac;
-    std::string animName = name + "[" + std::to_string(motionIndex) + "]";
+void DoLmt(LMTGLTF &main, uni::MotionsConst motion, std::string name,
+           ReportType &report) {
+  std::vector<AnimJob> jobs;
 
-    if (loopTime == 0.f) {
-      animName.append("_loop");
+  for (size_t motionIndex = 0; auto m : *motion) {
+    if (m) {
+      AnimJob &job = jobs.emplace_back();
+      job.animation = static_cast<const LMTAnimation *>(m.get());
+      job.motionIndex = motionIndex;
     }
 
-    uint32 loopFrame = [&]() -> uint32 {
-      if (loopTime > 0.f) {
-        return gltfutils::FindTimeEndIndex(times, loopTime);
-      }
+    motionIndex++;
+  }
 
-      return 0;
-    }();
+  // Prepared jobs hold sampled channels, only single batch is kept in memory
+  const size_t batchSize = NumWorkers(settings.numWorkers, jobs.size()) * 4;
 
-    DumpAnim(engine, main, animName, times, loopFrame, report);
+  for (size_t begin = 0; begin < jobs.size(); begin += batchSize) {
+    const size_t end = std::min(begin + batchSize, jobs.size());
 
-    motionIndex++;
+    RunWorkStealing(settings.numWorkers, end - begin,
+                    [&](size_t, size_t index) {
+                      PrepareAnim(main, jobs[begin + index], name);
+                    });
+
+    // Buffer and accessor order must not depend on thread scheduling
+    for (size_t j = begin; j < end; j++) {
+      for (auto &msg : jobs[j].messages) {
+        printline(msg);
+      }
+
+      DumpAnim(jobs[j], main, report);
+      jobs[j] = {};
+    }
   }
 }
 
@@ -21,12 +21,15 @@
 #include "spike/io/binreader_stream.hpp"
 #include "spike/io/binwritter_stream.hpp"
 #include "spike/io/fileinfo.hpp"
+#include "work_stealing.hpp"
 
 std::string_view filters[]{
     ".tex$",
 };
 
 struct TEXConvert : ReflectorBase<TEXConvert>, Tex2DdsSettings {
+  uint32 numWorkers = 1;
+  bool streaming = false;
 } settings;
 
 REFLECT(CLASS(TEXConvert),
@@ -39,7 +42,13 @@ REFLECT(CLASS(TEXConvert),
         MEMBERNAME(noMips, "largest-mipmap-only", "m",
                    ReflDesc{"Will try to extract only highest mipmap."}),
         MEMBERNAME(platformOverride, "platform", "p",
-                   ReflDesc{"Set platform for correct texture handling."}));
+                   ReflDesc{"Set platform for correct texture handling."}),
+        MEMBERNAME(numWorkers, "workers", "w",
+                   ReflDesc{"Number of threads converting mipmaps of single "
+                            "texture. 0 = all cores."}),
+        MEMBER(streaming, "s",
+               ReflDesc{"Convert one mipmap at a time to save memory on "
+                        "large textures. Workers are not used."}));
 
 static AppInfo_s appInfo{
     .filteredLoad = true,
@@ -53,9 +62,18 @@ AppInfo_s *AppInitModule() { return &appInfo; }
 
 void AppProcessFile(AppContext *ctx) {
   TEX tex;
-  tex.Load(ctx->GetStream(), settings.platformOverride);
-
   AFileInfo fleInfo0(ctx->workingFile);
+
+  if (settings.streaming) {
+    BinWritterRef wr(ctx->NewFile(fleInfo0.ChangeExtension(".dds")).str);
+    tex.StreamAsDDS(ctx->GetStream(), wr, settings);
+    return;
+  }
+
+  tex.LoadDeferred(ctx->GetStream(), settings.platformOverride);
+  RunWorkStealing(settings.numWorkers, tex.NumTasks(),
+                  [&](size_t, size_t index) { tex.RunTask(index); });
+
   BinWritterRef wr(ctx->NewFile(fleInfo0.ChangeExtension(".dds")).str);
   tex.SaveAsDDS(wr, settings);
 }